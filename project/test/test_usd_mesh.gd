@@ -111,3 +111,379 @@ func _find_child_mesh_instances(node: Node) -> Array:
 		results.append_array(_find_child_mesh_instances(child))
 
 	return results
+
+# Converts all root prims of the stage at path into a new node, configure gets the converter before that
+func _convert_stage(path: String, configure := Callable()) -> Node3D:
+	var stage := UsdStage.new()
+	assert_bool(stage.load(path)).is_true()
+
+	var converter := UsdGodotSceneConverter.new()
+	assert_bool(converter.load(stage)).is_true()
+	if configure.is_valid():
+		configure.call(converter)
+
+	var root := Node3D.new()
+	for prim in stage.get_root_prims():
+		converter.convert_prim(prim, root, stage.get_up_axis())
+	converter.build_pending_meshes()
+	return root
+
+func test_instances_share_prototype():
+	var root := _convert_stage("res://test/scenes/instancing/forest.usda", func(converter: UsdGodotSceneConverter):
+		converter.set_multimesh_instance_threshold(0))
+
+	var mesh_instances := root.find_children("*", "ImporterMeshInstance3D", true, false)
+	assert_int(mesh_instances.size()).is_equal(3)
+	for mesh_instance in mesh_instances:
+		assert_that(mesh_instance.mesh).is_same(mesh_instances[0].mesh)
+
+	root.free()
+
+	root = _convert_stage("res://test/scenes/instancing/forest.usda", func(converter: UsdGodotSceneConverter):
+		converter.set_multimesh_instance_threshold(3))
+
+	var multimesh_instances := root.find_children("*", "MultiMeshInstance3D", true, false)
+	assert_int(multimesh_instances.size()).is_equal(1)
+	assert_int(multimesh_instances[0].multimesh.instance_count).is_equal(3)
+
+	root.free()
+
+func test_point_instancer_to_multimesh():
+	var stage := UsdStage.new()
+	assert_bool(stage.load("res://test/scenes/instancing/scatter.usda")).is_true()
+
+	var instancer: UsdPrimValuePointInstancer = stage.get_prim_at_path(UsdPath.from_string("/scatter")).get_value()
+	assert_that(instancer).is_not_null()
+	assert_int(instancer.get_positions().size()).is_equal(4)
+	assert_int(instancer.get_prototypes().size()).is_equal(2)
+
+	var root := _convert_stage("res://test/scenes/instancing/scatter.usda")
+
+	var multimesh_instances := root.find_children("*", "MultiMeshInstance3D", true, false)
+	assert_int(multimesh_instances.size()).is_equal(2)
+
+	var instance_counts := []
+	for multimesh_instance in multimesh_instances:
+		instance_counts.append(multimesh_instance.multimesh.instance_count)
+	instance_counts.sort()
+	assert_array(instance_counts).is_equal([1, 3])
+
+	root.free()
+
+func test_instances_with_different_point_instancers_stay_apart():
+	var root := _convert_stage("res://test/scenes/instancing/patches.usda", func(converter: UsdGodotSceneConverter):
+		converter.set_multimesh_instance_threshold(0))
+
+	# The patches only differ in the positions of their point instancers
+	var offsets := []
+	for patch_name in ["patch_a", "patch_b"]:
+		var multimesh_instances := root.find_child(patch_name, true, false).find_children("*", "MultiMeshInstance3D", true, false)
+		assert_int(multimesh_instances.size()).is_equal(1)
+		offsets.append(multimesh_instances[0].multimesh.get_instance_transform(1).origin.x)
+	assert_array(offsets).is_equal([1.0, 5.0])
+
+	root.free()
+
+func test_subdivision_refines_cage():
+	var stage := UsdStage.new()
+	assert_bool(stage.load("res://test/scenes/subdiv/cube.usda")).is_true()
+
+	var geom_mesh: UsdPrimValueGeomMesh = stage.get_prim_at_path(UsdPath.from_string("/cube")).get_value()
+	assert_int(geom_mesh.get_subdivision_scheme()).is_equal(UsdPrimValueGeomMesh.SUBDIVISION_SCHEME_CATMULL_CLARK)
+
+	var converter := UsdGodotSceneConverter.new()
+	assert_bool(converter.load(stage)).is_true()
+
+	var cage: ImporterMesh = converter.convert_mesh(geom_mesh)
+	converter.set_subdivision_level(2)
+	var refined: ImporterMesh = converter.convert_mesh(geom_mesh)
+
+	var cage_vertices: PackedVector3Array = cage.get_surface_arrays(0)[Mesh.ARRAY_VERTEX]
+	var refined_arrays := refined.get_surface_arrays(0)
+	assert_int(refined_arrays[Mesh.ARRAY_VERTEX].size()).is_greater(cage_vertices.size())
+	assert_int(refined_arrays[Mesh.ARRAY_NORMAL].size()).is_equal(refined_arrays[Mesh.ARRAY_VERTEX].size())
+
+func test_subdivision_budget_and_lods():
+	var root := _convert_stage("res://test/scenes/subdiv/cube.usda", func(converter: UsdGodotSceneConverter):
+		converter.set_build_meshes_in_parallel(true)
+		converter.set_subdivision_level(3)
+		# 12 cage triangles, 48 after one level and 192 after two
+		converter.set_subdivision_triangle_budget(100))
+
+	var mesh_instances := root.find_children("*", "ImporterMeshInstance3D", true, false)
+	assert_int(mesh_instances.size()).is_equal(1)
+	var mesh: ImporterMesh = mesh_instances[0].mesh
+	var indices: PackedInt32Array = mesh.get_surface_arrays(0)[Mesh.ARRAY_INDEX]
+	assert_int(indices.size()).is_equal(48 * 3)
+	# The cage is kept as the one coarser level
+	assert_int(mesh.get_surface_lod_count(0)).is_equal(1)
+	assert_int(mesh.get_surface_lod_indices(0, 0).size()).is_equal(12 * 3)
+
+	root.free()
+
+func _convert_copies_with_budget(budget: int) -> Array:
+	var root := _convert_stage("res://test/scenes/subdiv/copies.usda", func(converter: UsdGodotSceneConverter):
+		converter.set_build_meshes_in_parallel(true)
+		converter.set_share_duplicate_meshes(true)
+		converter.set_subdivision_level(3)
+		converter.set_subdivision_triangle_budget(budget))
+
+	var triangle_counts := []
+	for mesh_instance in root.find_children("*", "ImporterMeshInstance3D", true, false):
+		triangle_counts.append(mesh_instance.mesh.get_surface_arrays(0)[Mesh.ARRAY_INDEX].size() / 3)
+	root.free()
+	return triangle_counts
+
+func test_subdivision_budget_counts_shared_meshes_per_reference():
+	# One cube refined once has 48 triangles, which fits in 100 but three of them don't
+	assert_array(_convert_copies_with_budget(100)).is_equal([12, 12, 12])
+	assert_array(_convert_copies_with_budget(150)).is_equal([48, 48, 48])
+
+func test_generated_normals_split_at_crease_angle():
+	var stage := UsdStage.new()
+	assert_bool(stage.load("res://test/scenes/normals/cube.usda")).is_true()
+
+	var geom_mesh: UsdPrimValueGeomMesh = stage.get_prim_at_path(UsdPath.from_string("/cube")).get_value()
+	assert_int(geom_mesh.get_normals().size()).is_equal(0)
+
+	var converter := UsdGodotSceneConverter.new()
+	assert_bool(converter.load(stage)).is_true()
+
+	# The faces meet at 90 degrees, so every face keeps its own flat normal
+	var hard: ImporterMesh = converter.convert_mesh(geom_mesh)
+	var hard_arrays := hard.get_surface_arrays(0)
+	assert_int(hard_arrays[Mesh.ARRAY_VERTEX].size()).is_equal(24)
+	for normal in hard_arrays[Mesh.ARRAY_NORMAL]:
+		assert_float(absf(normal.x) + absf(normal.y) + absf(normal.z)).is_equal_approx(1.0, 0.0001)
+
+	converter.set_normal_crease_angle(180.0)
+	var smooth: ImporterMesh = converter.convert_mesh(geom_mesh)
+	var smooth_arrays := smooth.get_surface_arrays(0)
+	assert_int(smooth_arrays[Mesh.ARRAY_VERTEX].size()).is_equal(8)
+	for i in smooth_arrays[Mesh.ARRAY_VERTEX].size():
+		assert_vector(smooth_arrays[Mesh.ARRAY_NORMAL][i]).is_equal_approx(smooth_arrays[Mesh.ARRAY_VERTEX][i].normalized(), Vector3.ONE * 0.0001)
+
+func test_tangents_for_normal_mapped_surfaces():
+	var stage := UsdStage.new()
+	assert_bool(stage.load("res://test/scenes/tangents/normalmapped.usda")).is_true()
+
+	var converter := UsdGodotSceneConverter.new()
+	assert_bool(converter.load(stage)).is_true()
+
+	var geom_mesh: UsdPrimValueGeomMesh = stage.get_prim_at_path(UsdPath.from_string("/root/quad")).get_value()
+	var mesh: ImporterMesh = converter.convert_mesh(geom_mesh)
+	assert_that(mesh.get_surface_material(0).normal_texture).is_not_null()
+
+	var arrays := mesh.get_surface_arrays(0)
+	var tangents: PackedFloat32Array = arrays[Mesh.ARRAY_TANGENT]
+	assert_int(tangents.size()).is_equal(arrays[Mesh.ARRAY_VERTEX].size() * 4)
+	# u runs along +x on the quad
+	for i in range(0, tangents.size(), 4):
+		assert_vector(Vector3(tangents[i], tangents[i + 1], tangents[i + 2])).is_equal_approx(Vector3.RIGHT, Vector3.ONE * 0.0001)
+
+	var untextured := UsdStage.new()
+	assert_bool(untextured.load("res://test/scenes/normals/cube.usda")).is_true()
+	assert_bool(converter.load(untextured)).is_true()
+	var cube: ImporterMesh = converter.convert_mesh(untextured.get_prim_at_path(UsdPath.from_string("/cube")).get_value())
+	assert_that(cube.get_surface_arrays(0)[Mesh.ARRAY_TANGENT]).is_null()
+
+func test_simplified_lod_chain():
+	var stage := UsdStage.new()
+	assert_bool(stage.load("res://test/scenes/subdiv/cube.usda")).is_true()
+
+	var converter := UsdGodotSceneConverter.new()
+	assert_bool(converter.load(stage)).is_true()
+	# 768 triangles without the subdivision levels as LODs, so they come from simplification
+	converter.set_subdivision_level(3)
+	converter.set_subdivision_lods(false)
+
+	var mesh: ImporterMesh = converter.convert_mesh(stage.get_prim_at_path(UsdPath.from_string("/cube")).get_value())
+	var vertex_count: int = mesh.get_surface_arrays(0)[Mesh.ARRAY_VERTEX].size()
+	var index_count: int = mesh.get_surface_arrays(0)[Mesh.ARRAY_INDEX].size()
+	assert_int(mesh.get_surface_lod_count(0)).is_greater(0)
+
+	for lod in mesh.get_surface_lod_count(0):
+		var lod_indices := mesh.get_surface_lod_indices(0, lod)
+		assert_int(lod_indices.size()).is_less(index_count)
+		index_count = lod_indices.size()
+		for index in lod_indices:
+			assert_int(index).is_less(vertex_count)
+
+	converter.set_generate_lods(false)
+	mesh = converter.convert_mesh(stage.get_prim_at_path(UsdPath.from_string("/cube")).get_value())
+	assert_int(mesh.get_surface_lod_count(0)).is_equal(0)
+
+func test_vertex_order_optimization():
+	var stage := UsdStage.new()
+	assert_bool(stage.load("res://test/scenes/subdiv/cube.usda")).is_true()
+
+	var converter := UsdGodotSceneConverter.new()
+	assert_bool(converter.load(stage)).is_true()
+	converter.set_subdivision_level(2)
+	var geom_mesh: UsdPrimValueGeomMesh = stage.get_prim_at_path(UsdPath.from_string("/cube")).get_value()
+
+	converter.set_optimize_vertex_order(false)
+	var raw_arrays := converter.convert_mesh(geom_mesh).get_surface_arrays(0)
+	converter.set_optimize_vertex_order(true)
+	var optimized_arrays := converter.convert_mesh(geom_mesh).get_surface_arrays(0)
+
+	assert_int(optimized_arrays[Mesh.ARRAY_INDEX].size()).is_equal(raw_arrays[Mesh.ARRAY_INDEX].size())
+	assert_int(optimized_arrays[Mesh.ARRAY_VERTEX].size()).is_equal(raw_arrays[Mesh.ARRAY_VERTEX].size())
+
+	# Vertices are stored in the order the triangles first use them
+	var next_vertex := 0
+	for index in optimized_arrays[Mesh.ARRAY_INDEX]:
+		assert_int(index).is_less_equal(next_vertex)
+		if index == next_vertex:
+			next_vertex += 1
+
+func test_large_mesh_split_into_chunks():
+	var root := _convert_stage("res://test/scenes/subdiv/cube.usda", func(converter: UsdGodotSceneConverter):
+		converter.set_build_meshes_in_parallel(true)
+		converter.set_subdivision_level(3)
+		converter.set_chunk_triangle_count(128))
+
+	var mesh_instances := root.find_children("*", "ImporterMeshInstance3D", true, false)
+	assert_int(mesh_instances.size()).is_greater(1)
+	# The chunks hold every triangle of the 768 refined ones exactly once
+	var triangle_count := 0
+	for mesh_instance in mesh_instances:
+		var mesh: ImporterMesh = mesh_instance.mesh
+		for surface_idx in mesh.get_surface_count():
+			triangle_count += mesh.get_surface_arrays(surface_idx)[Mesh.ARRAY_INDEX].size() / 3
+	assert_int(triangle_count).is_equal(768)
+
+	root.free()
+
+func test_meters_per_unit_applied_to_points_and_transforms():
+	var stage := UsdStage.new()
+	assert_bool(stage.load("res://test/scenes/units/box.usda")).is_true()
+	assert_float(stage.get_meters_per_unit()).is_equal_approx(0.01, 0.000001)
+
+	var root := _convert_stage("res://test/scenes/units/box.usda", func(converter: UsdGodotSceneConverter):
+		converter.set_unit_scale(stage.get_meters_per_unit()))
+
+	var mesh_instances := root.find_children("*", "ImporterMeshInstance3D", true, false)
+	assert_int(mesh_instances.size()).is_equal(1)
+	# The Z up translation becomes Y up and is scaled from centimeters to meters
+	assert_vector(mesh_instances[0].position).is_equal_approx(Vector3(0, 2, 0), Vector3.ONE * 0.0001)
+
+	var arrays: Array = mesh_instances[0].mesh.get_surface_arrays(0)
+	for i in arrays[Mesh.ARRAY_VERTEX].size():
+		var vertex: Vector3 = arrays[Mesh.ARRAY_VERTEX][i]
+		assert_vector(vertex.abs()).is_equal_approx(Vector3.ONE * 0.5, Vector3.ONE * 0.0001)
+		# Normals generated from the swizzled points still face outwards
+		assert_float(arrays[Mesh.ARRAY_NORMAL][i].dot(vertex)).is_greater(0.0)
+
+	root.free()
+
+func test_parallel_build_of_more_multi_surface_meshes_than_threads():
+	var stage := UsdStage.new()
+	assert_bool(stage.load("res://test/scenes/2meshes.usda")).is_true()
+
+	var converter := UsdGodotSceneConverter.new()
+	assert_bool(converter.load(stage)).is_true()
+	converter.set_build_meshes_in_parallel(true)
+	converter.set_share_duplicate_meshes(false)
+	converter.set_generate_lods(true)
+	converter.set_optimize_vertex_order(true)
+
+	# Every mesh opens nested parallel passes over its two surfaces while all pool threads build meshes
+	var plane: UsdPrim = stage.get_prim_at_path(UsdPath.from_string("/root/MyPlane"))
+	var mesh_count := OS.get_processor_count() * 2 + 1
+	var root := Node3D.new()
+	for i in mesh_count:
+		converter.convert_prim(plane, root, stage.get_up_axis())
+	converter.build_pending_meshes()
+
+	var mesh_instances := root.find_children("*", "ImporterMeshInstance3D", true, false)
+	assert_int(mesh_instances.size()).is_equal(mesh_count)
+	for mesh_instance in mesh_instances:
+		assert_int(mesh_instance.mesh.get_surface_count()).is_equal(2)
+
+	root.free()
+
+func test_faces_without_material_get_their_own_surface():
+	var stage := UsdStage.new()
+	assert_bool(stage.load("res://test/scenes/subsets/strip.usda")).is_true()
+
+	var converter := UsdGodotSceneConverter.new()
+	assert_bool(converter.load(stage)).is_true()
+	var geom_mesh: UsdPrimValueGeomMesh = stage.get_prim_at_path(UsdPath.from_string("/root/strip")).get_value()
+	var mesh: ImporterMesh = converter.convert_mesh(geom_mesh)
+
+	# One surface per subset, then one for the faces no subset covers. The out of range index is skipped
+	assert_int(mesh.get_surface_count()).is_equal(3)
+	assert_str(mesh.get_surface_name(0)).is_equal("red")
+	assert_str(mesh.get_surface_name(1)).is_equal("blue")
+	assert_that(mesh.get_surface_material(0).albedo_color).is_equal(Color(1, 0, 0))
+	assert_that(mesh.get_surface_material(1).albedo_color).is_equal(Color(0, 0, 1))
+	assert_object(mesh.get_surface_material(2)).is_null()
+
+	var triangle_counts := []
+	for surface_idx in mesh.get_surface_count():
+		triangle_counts.append(mesh.get_surface_arrays(surface_idx)[Mesh.ARRAY_INDEX].size() / 3)
+	assert_array(triangle_counts).is_equal([2, 2, 4])
+
+func test_identical_meshes_share_one_importer_mesh():
+	var root := _convert_stage("res://test/scenes/sharing/quads.usda", func(converter: UsdGodotSceneConverter):
+		converter.set_share_duplicate_meshes(true))
+
+	var plain_a: ImporterMeshInstance3D = root.find_child("plain_a", true, false)
+	var plain_b: ImporterMeshInstance3D = root.find_child("plain_b", true, false)
+	var bound: ImporterMeshInstance3D = root.find_child("bound", true, false)
+	var with_uvs: ImporterMeshInstance3D = root.find_child("with_uvs", true, false)
+
+	# Same geometry under different transforms
+	assert_object(plain_a.mesh).is_same(plain_b.mesh)
+	assert_vector(plain_b.position).is_equal(Vector3(3, 0, 0))
+	# Same points and topology, but a material binding or an extra primvar changes the mesh
+	assert_object(bound.mesh).is_not_same(plain_a.mesh)
+	assert_object(with_uvs.mesh).is_not_same(plain_a.mesh)
+	assert_object(with_uvs.mesh).is_not_same(bound.mesh)
+
+	root.free()
+
+func test_shared_meshes_rebuilt_after_options_change():
+	var stage := UsdStage.new()
+	assert_bool(stage.load("res://test/scenes/sharing/quads.usda")).is_true()
+
+	var converter := UsdGodotSceneConverter.new()
+	assert_bool(converter.load(stage)).is_true()
+	converter.set_share_duplicate_meshes(true)
+
+	var plain_a: UsdPrim = stage.get_prim_at_path(UsdPath.from_string("/root/a/plain_a"))
+	var first: ImporterMeshInstance3D = converter.convert_prim(plain_a, null, stage.get_up_axis())
+	converter.set_unit_scale(2.0)
+	var second: ImporterMeshInstance3D = converter.convert_prim(plain_a, null, stage.get_up_axis())
+
+	assert_object(second.mesh).is_not_same(first.mesh)
+	var first_extent: float = first.mesh.get_surface_arrays(0)[Mesh.ARRAY_VERTEX][0].length()
+	var second_extent: float = second.mesh.get_surface_arrays(0)[Mesh.ARRAY_VERTEX][0].length()
+	assert_float(second_extent).is_equal_approx(first_extent * 2.0, 0.0001)
+
+	first.free()
+	second.free()
+
+func test_subdivision_tags_keep_meshes_apart():
+	var stage := UsdStage.new()
+	assert_bool(stage.load("res://test/scenes/subdiv/schemes.usda")).is_true()
+
+	# Same points and topology, only the scheme or the creases differ
+	var hashes := {}
+	for name in ["smooth", "flat", "creased", "soft_crease"]:
+		var geom_mesh: UsdPrimValueGeomMesh = stage.get_prim_at_path(UsdPath.from_string("/cubes/" + name)).get_value()
+		hashes[geom_mesh.get_geometry_hash()] = name
+	assert_int(hashes.size()).is_equal(4)
+
+	var root := _convert_stage("res://test/scenes/subdiv/schemes.usda", func(converter: UsdGodotSceneConverter):
+		converter.set_share_duplicate_meshes(true)
+		converter.set_subdivision_level(1))
+
+	var smooth: ImporterMeshInstance3D = root.find_child("smooth", true, false)
+	var flat: ImporterMeshInstance3D = root.find_child("flat", true, false)
+	assert_object(smooth.mesh).is_not_same(flat.mesh)
+	assert_int(smooth.mesh.get_surface_arrays(0)[Mesh.ARRAY_INDEX].size()).is_equal(48 * 3)
+	assert_int(flat.mesh.get_surface_arrays(0)[Mesh.ARRAY_INDEX].size()).is_equal(12 * 3)
+
+	root.free()
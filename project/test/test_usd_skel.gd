@@ -20,3 +20,49 @@ func test_compare_gltf_skeleton():
 
 	usd_node.queue_free()
 	expected_node.queue_free()
+
+func _convert_skinned_mesh(stage: UsdStage, path: String) -> ImporterMesh:
+	var converter := UsdGodotSceneConverter.new()
+	assert_bool(converter.load(stage)).is_true()
+	var geom_mesh: UsdPrimValueGeomMesh = stage.get_prim_at_path(UsdPath.from_string(path)).get_value()
+	return converter.convert_mesh(geom_mesh)
+
+# Every vertex of the fixture meshes has the same influences, so checking the first one is enough
+func _assert_first_influences(mesh: ImporterMesh, bones: PackedInt32Array, weights: PackedFloat32Array) -> void:
+	var arrays := mesh.get_surface_arrays(0)
+	var vertex_count: int = arrays[Mesh.ARRAY_VERTEX].size()
+	assert_int(arrays[Mesh.ARRAY_BONES].size()).is_equal(vertex_count * bones.size())
+	assert_int(arrays[Mesh.ARRAY_WEIGHTS].size()).is_equal(vertex_count * weights.size())
+	for k in bones.size():
+		assert_int(arrays[Mesh.ARRAY_BONES][k]).is_equal(bones[k])
+		assert_float(arrays[Mesh.ARRAY_WEIGHTS][k]).is_equal_approx(weights[k], 0.0001)
+
+func test_skin_influences_per_element_size():
+	var stage := UsdStage.new()
+	assert_bool(stage.load("res://test/scenes/skin/weights.usda")).is_true()
+
+	# Fewer than 4 influences are padded and renormalized
+	var two := _convert_skinned_mesh(stage, "/skin/two")
+	assert_int(two.get_surface_format(0) & Mesh.ARRAY_FLAG_USE_8_BONE_WEIGHTS).is_equal(0)
+	_assert_first_influences(two, PackedInt32Array([1, 3, 0, 0]), PackedFloat32Array([0.75, 0.25, 0.0, 0.0]))
+
+	# More than 4 use Godot's 8 bone layout
+	var six := _convert_skinned_mesh(stage, "/skin/six")
+	assert_int(six.get_surface_format(0) & Mesh.ARRAY_FLAG_USE_8_BONE_WEIGHTS).is_not_equal(0)
+	_assert_first_influences(six, PackedInt32Array([0, 1, 2, 3, 4, 5, 0, 0]), PackedFloat32Array([0.1, 0.1, 0.2, 0.2, 0.2, 0.2, 0.0, 0.0]))
+
+	# More than 8 keep the strongest 8, strongest first, renormalized to their sum of 0.52
+	var ten := _convert_skinned_mesh(stage, "/skin/ten")
+	assert_int(ten.get_surface_format(0) & Mesh.ARRAY_FLAG_USE_8_BONE_WEIGHTS).is_not_equal(0)
+	var kept_weights := PackedFloat32Array()
+	for weight in [0.10, 0.09, 0.08, 0.07, 0.06, 0.05, 0.04, 0.03]:
+		kept_weights.append(weight / 0.52)
+	_assert_first_influences(ten, PackedInt32Array([9, 8, 7, 6, 5, 4, 3, 2]), kept_weights)
+
+	# Constant influences apply to every point
+	var constant := _convert_skinned_mesh(stage, "/skin/constant")
+	var constant_arrays := constant.get_surface_arrays(0)
+	for vertex in constant_arrays[Mesh.ARRAY_VERTEX].size():
+		for k in 4:
+			assert_int(constant_arrays[Mesh.ARRAY_BONES][vertex * 4 + k]).is_equal([4, 5, 6, 0][k])
+			assert_float(constant_arrays[Mesh.ARRAY_WEIGHTS][vertex * 4 + k]).is_equal_approx([0.5, 0.25, 0.25, 0.0][k], 0.0001)
@@ -0,0 +1,112 @@
+extends GdUnitTestSuite
+
+func test_load_stage():
+	var stage := UsdStage.new()
+	assert_bool(stage.load("res://test/scenes/2meshes.usda")).is_true()
+	assert_bool(stage.is_valid()).is_true()
+	assert_int(stage.get_root_prims().size()).is_greater(0)
+
+func test_load_stage_async():
+	var stage := UsdStage.new()
+	assert_int(stage.load_async("res://test/scenes/2meshes.usda")).is_equal(OK)
+	assert_bool(stage.is_valid()).is_false()
+
+	var success: bool = await stage.loaded
+	assert_bool(success).is_true()
+	assert_bool(stage.is_loading()).is_false()
+	assert_bool(stage.is_valid()).is_true()
+	assert_int(stage.get_root_prims().size()).is_greater(0)
+
+func test_load_stage_async_no_progress_after_wait():
+	var stage := UsdStage.new()
+	var events: Array[String] = []
+	stage.progress.connect(func(_ratio: float): events.append("progress"))
+	stage.loaded.connect(func(_success: bool): events.append("loaded"))
+
+	assert_int(stage.load_async("res://test/scenes/2meshes.usda")).is_equal(OK)
+	assert_bool(stage.wait_for_load()).is_true()
+	# Progress the worker queued before the hand-off must not arrive after loaded
+	await get_tree().process_frame
+	await get_tree().process_frame
+	assert_str(events.back()).is_equal("loaded")
+	assert_int(events.count("loaded")).is_equal(1)
+
+func test_load_stage_async_missing_file():
+	var stage := UsdStage.new()
+	stage.load_async("res://test/scenes/does_not_exist.usda")
+	assert_bool(stage.wait_for_load()).is_false()
+	assert_bool(stage.is_valid()).is_false()
+
+func test_payloads_unloaded_by_default():
+	var stage := UsdStage.new()
+	assert_bool(stage.load("res://test/scenes/payloads/set.usda")).is_true()
+
+	var prop := UsdPath.from_string("/set/prop")
+	assert_int(stage.get_payload_paths().size()).is_equal(1)
+	assert_bool(stage.is_payload_loaded(prop)).is_false()
+	assert_bool(stage.get_prim_at_path(UsdPath.from_string("/set/prop/box")).is_valid()).is_false()
+
+	assert_bool(stage.load_payload(prop)).is_true()
+	assert_bool(stage.is_payload_loaded(prop)).is_true()
+	assert_bool(stage.get_prim_at_path(UsdPath.from_string("/set/prop/box")).is_valid()).is_true()
+
+	assert_bool(stage.unload_payload(prop)).is_true()
+	assert_bool(stage.get_prim_at_path(UsdPath.from_string("/set/prop/box")).is_valid()).is_false()
+
+func test_stage_cache():
+	UsdStage.clear_cache()
+	var first := UsdStage.new()
+	var second := UsdStage.new()
+	assert_bool(first.load("res://test/scenes/2meshes.usda")).is_true()
+	assert_bool(second.load("res://test/scenes/2meshes.usda")).is_true()
+	assert_int(second.get_root_prims().size()).is_equal(first.get_root_prims().size())
+
+	UsdStage.clear_cache()
+	assert_bool(first.is_valid()).is_true()
+
+func _write_part_layer(path: String, child_name: String) -> void:
+	var file := FileAccess.open(path, FileAccess.WRITE)
+	file.store_string('#usda 1.0\n(\n    defaultPrim = "part"\n)\n\ndef Xform "part"\n{\n    def Xform "%s"\n    {\n    }\n}\n' % child_name)
+	file.close()
+
+func test_stage_cache_reloads_changed_reference():
+	UsdStage.clear_cache()
+	var dir := "user://stage_cache_test"
+	DirAccess.make_dir_recursive_absolute(dir)
+	var root_file := FileAccess.open(dir + "/root.usda", FileAccess.WRITE)
+	root_file.store_string('#usda 1.0\n(\n    defaultPrim = "root"\n)\n\ndef Xform "root" (\n    prepend references = @./part.usda@\n)\n{\n}\n')
+	root_file.close()
+	_write_part_layer(dir + "/part.usda", "first")
+
+	var stage := UsdStage.new()
+	assert_bool(stage.load(dir + "/root.usda")).is_true()
+	assert_bool(stage.get_prim_at_path(UsdPath.from_string("/root/first")).is_valid()).is_true()
+
+	# Modification times only have a resolution of one second
+	await get_tree().create_timer(1.1).timeout
+	_write_part_layer(dir + "/part.usda", "second")
+
+	# The root file didn't change, only the referenced one
+	var reloaded := UsdStage.new()
+	assert_bool(reloaded.load(dir + "/root.usda")).is_true()
+	assert_bool(reloaded.get_prim_at_path(UsdPath.from_string("/root/second")).is_valid()).is_true()
+	assert_bool(reloaded.get_prim_at_path(UsdPath.from_string("/root/first")).is_valid()).is_false()
+	UsdStage.clear_cache()
+
+func test_traverse():
+	var stage := UsdStage.new()
+	assert_bool(stage.load("res://test/scenes/2meshes.usda")).is_true()
+
+	var hierarchy := stage.traverse()
+	var paths: PackedStringArray = hierarchy["paths"]
+	var parents: PackedInt32Array = hierarchy["parents"]
+	var child_start: PackedInt32Array = hierarchy["child_start"]
+	var child_count: PackedInt32Array = hierarchy["child_count"]
+	assert_int(paths.size()).is_equal(parents.size())
+	assert_int(hierarchy["types"].size()).is_equal(paths.size())
+	assert_int(parents[0]).is_equal(-1)
+
+	for i in paths.size():
+		for child in range(child_start[i], child_start[i] + child_count[i]):
+			assert_int(parents[child]).is_equal(i)
+			assert_str(paths[child].get_base_dir()).is_equal(paths[i])
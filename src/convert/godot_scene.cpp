@@ -2,6 +2,8 @@
 
 #include <godot_cpp/classes/array_mesh.hpp>
 #include <godot_cpp/classes/importer_mesh.hpp>
+#include <godot_cpp/classes/multi_mesh.hpp>
+#include <godot_cpp/classes/multi_mesh_instance3d.hpp>
 #include <godot_cpp/classes/node.hpp>
 #include <godot_cpp/classes/node3d.hpp>
 #include <godot_cpp/classes/packed_scene.hpp>
@@ -14,12 +16,20 @@
 #include <godot_cpp/variant/packed_string_array.hpp>
 #include <godot_cpp/variant/typed_array.hpp>
 
+#include <queue>
+#include <utility>
+#include <vector>
+
+#include "convert/mesh_builder.h"
 #include "usd/usd_geom.h"
 #include "usd/usd_prim.h"
 #include "usd/usd_prim_type.h"
+#include "usd/usd_skel.h"
 #include "usd/usd_stage.h"
 #include "utils/geom_utils.h"
 #include "utils/godot_utils.h"
+#include "utils/hash_utils.h"
+#include "utils/thread_utils.h"
 
 using namespace godot;
 
@@ -33,268 +43,198 @@ Node *get_owner(Node *node) {
 	return owner;
 }
 
-bool is_mesh_instance(const Ref<UsdPrim> &prim) {
-	//check if children are meshes
-	const TypedArray<UsdPrim> &children = prim->get_children();
-	if (children.size() != 1) {
-		return false;
+void set_owner_recursive(Node *node, Node *owner) {
+	node->set_owner(owner);
+	for (int i = 0; i < node->get_child_count(); i++) {
+		set_owner_recursive(node->get_child(i), owner);
 	}
-	const Ref<UsdPrim> &child = children[0];
-	return child->get_type() == UsdPrimType::USD_PRIM_TYPE_MESH;
 }
 
-Ref<ImporterMesh> UsdGodotSceneConverter::convert_mesh(const Ref<UsdPrimValueGeomMesh> &geom_mesh, const Vector3::Axis up_axis) {
-	ERR_FAIL_COND_V_MSG(geom_mesh.is_null(), nullptr, "GeomMesh is null");
-	ERR_FAIL_COND_V_MSG(_materials.is_null(), nullptr, "Materials is null");
-
-	Ref<ImporterMesh> mesh;
-	mesh.instantiate();
-	mesh->set_name(geom_mesh->get_name());
-
-	PackedVector3Array points = apply_up_axis(geom_mesh->get_points(), up_axis);
-	PackedVector3Array normals = apply_up_axis(geom_mesh->get_normals(), up_axis);
-	PackedInt32Array face_vertex_counts = geom_mesh->get_face_vertex_counts();
-	PackedInt32Array face_vertex_indices = geom_mesh->get_face_vertex_indices();
-
-	Ref<UsdGeomMeshMaterialMap> material_map = geom_mesh->get_material_map();
-
-	Ref<UsdGeomPrimvar> uv_primvar;
-	bool has_uvs = geom_mesh->has_primvar(UsdPrimValueGeomMesh::PRIMVAR_TEX_UV);
-	if (has_uvs) {
-		uv_primvar = geom_mesh->get_primvar(UsdPrimValueGeomMesh::PRIMVAR_TEX_UV);
-	}
-
-	Ref<UsdGeomPrimvar> bone_primvar;
-	bool has_bones = geom_mesh->has_primvar(UsdPrimValueGeomMesh::PRIMVAR_BONES);
-	if (has_bones) {
-		bone_primvar = geom_mesh->get_primvar(UsdPrimValueGeomMesh::PRIMVAR_BONES);
-	}
-
-	Ref<UsdGeomPrimvar> weight_primvar;
-	bool has_weights = geom_mesh->has_primvar(UsdPrimValueGeomMesh::PRIMVAR_WEIGHTS);
-	if (has_weights) {
-		weight_primvar = geom_mesh->get_primvar(UsdPrimValueGeomMesh::PRIMVAR_WEIGHTS);
+// Fills the whole transform buffer at once instead of one set_instance_transform call per instance.
+// local_transform is applied to the mesh before every instance transform
+Ref<MultiMesh> create_multimesh(const Ref<Mesh> &mesh, const Vector<Transform3D> &transforms, const Transform3D &local_transform = Transform3D()) {
+	PackedFloat32Array buffer;
+	buffer.resize(transforms.size() * 12);
+	float *buffer_ptr = buffer.ptrw();
+	const Transform3D *transforms_ptr = transforms.ptr();
+	const bool has_local_transform = local_transform != Transform3D();
+
+	for (int i = 0; i < transforms.size(); i++) {
+		const Transform3D transform = has_local_transform ? transforms_ptr[i] * local_transform : transforms_ptr[i];
+		float *dst = buffer_ptr + i * 12;
+		for (int row = 0; row < 3; row++) {
+			dst[row * 4 + 0] = transform.basis.rows[row].x;
+			dst[row * 4 + 1] = transform.basis.rows[row].y;
+			dst[row * 4 + 2] = transform.basis.rows[row].z;
+			dst[row * 4 + 3] = transform.origin[row];
+		}
 	}
 
-	PackedInt32Array triangulated_face_vertex_counts;
-	PackedInt32Array triangulated_face_vertex_indices;
-	PackedInt64Array triangulated_to_orig_face_vertex_index_map;
-	PackedInt32Array triangulated_face_counts;
-	String error;
-
-	bool success = triangulate_polygon(
-			points,
-			face_vertex_counts,
-			face_vertex_indices,
-			triangulated_face_vertex_counts,
-			triangulated_face_vertex_indices,
-			triangulated_to_orig_face_vertex_index_map,
-			triangulated_face_counts,
-			error);
-
-	ERR_FAIL_COND_V_MSG(!success, nullptr, "Failed to triangulate mesh: " + error);
-
-	PackedInt32Array face_material_indices;
-	TypedArray<UsdPath> material_paths;
-	PackedStringArray surface_names;
-	bool has_mapped_materials = material_map->is_mapped();
+	Ref<MultiMesh> multimesh;
+	multimesh.instantiate();
+	multimesh->set_transform_format(MultiMesh::TRANSFORM_3D);
+	multimesh->set_mesh(mesh);
+	multimesh->set_instance_count(transforms.size());
+	multimesh->set_buffer(buffer);
+	return multimesh;
+}
 
-	if (has_mapped_materials) {
-		face_material_indices = material_map->get_face_material_indices();
-		material_paths = material_map->get_materials();
-		surface_names = material_map->get_surface_names();
-	} else {
-		material_paths = material_map->get_materials();
+void hash_path(const Ref<UsdPath> &path, const String &root_path, ContentHasher &hasher) {
+	// Every instance has its own copy of the prototype, so paths inside of it are hashed relative to the instance
+	String path_string = path.is_valid() ? path->full_path() : String();
+	if (path_string.begins_with(root_path + "/")) {
+		path_string = path_string.substr(root_path.length());
 	}
+	const CharString path_utf8 = path_string.utf8();
+	hasher.add_buffer(path_utf8.get_data(), path_utf8.length());
+}
 
-	HashMap<int, Vector<int>> surface_indices;
-
-	int face_offset = 0;
-	int tri_face_index = 0;
-
-	if (has_mapped_materials) {
-		for (int i = 0; i < triangulated_face_counts.size(); i++) {
-			int num_tris = triangulated_face_counts[i];
-			int material_idx = face_material_indices[i];
+// Returns false if a prim in the subtree has content that isn't hashed, then two different prototypes could get the same hash
+bool hash_prototype_children(const Ref<UsdPrim> &prim, const String &root_path, ContentHasher &hasher) {
+	const TypedArray<UsdPrim> children = prim->get_children();
+	hasher.add(children.size());
 
-			if (!surface_indices.has(material_idx)) {
-				surface_indices[material_idx] = Vector<int>();
+	for (int i = 0; i < children.size(); i++) {
+		const Ref<UsdPrim> child = children[i];
+		const CharString name = child->get_name().utf8();
+		hasher.add_buffer(name.get_data(), name.length());
+		hasher.add(child->get_type());
+
+		switch (child->get_type()) {
+			case UsdPrimType::USD_PRIM_TYPE_XFORM: {
+				const Ref<UsdPrimValueXform> xform = child->get_value();
+				const Transform3D transform = xform->get_transform();
+				hasher.add_buffer(&transform, sizeof(Transform3D));
+				break;
 			}
-
-			for (int j = 0; j < num_tris; j++) {
-				surface_indices[material_idx].push_back(tri_face_index);
-				tri_face_index++;
+			case UsdPrimType::USD_PRIM_TYPE_MESH: {
+				const Ref<UsdPrimValueGeomMesh> geom_mesh = child->get_value();
+				hasher.add(uint64_t(geom_mesh->get_geometry_hash(root_path)));
+				break;
 			}
-
-			face_offset += face_vertex_counts[i];
-		}
-	} else {
-		int material_idx = 0;
-
-		int total_tris = 0;
-		for (int i = 0; i < triangulated_face_counts.size(); i++) {
-			total_tris += triangulated_face_counts[i];
-		}
-
-		Vector<int> all_triangles;
-		all_triangles.resize(total_tris);
-		for (int i = 0; i < total_tris; i++) {
-			all_triangles.write[i] = i;
-		}
-		surface_indices[material_idx] = all_triangles;
-	}
-
-	for (int material_idx = 0; material_idx < surface_indices.size(); material_idx++) {
-		const Vector<int> &triangle_indices = surface_indices[material_idx];
-
-		Array surface_arrays;
-		surface_arrays.resize(Mesh::ARRAY_MAX);
-
-		PackedVector3Array surface_vertices;
-		PackedVector3Array surface_normals;
-		PackedVector2Array surface_uvs;
-		PackedInt32Array surface_indices;
-
-		PackedFloat32Array surface_weights;
-		PackedInt32Array surface_bones;
-		bool has_skin = has_bones && has_weights;
-
-		for (int tri_idx : triangle_indices) {
-			int base_idx = tri_idx * 3;
-
-			for (int j = 0; j < 3; j++) {
-				int vertex_index = triangulated_face_vertex_indices[base_idx + j];
-				surface_vertices.push_back(points[vertex_index]);
-
-				if (!normals.is_empty() && vertex_index < normals.size()) {
-					surface_normals.push_back(normals[vertex_index]);
+			case UsdPrimType::USD_PRIM_TYPE_SKELETON: {
+				const Ref<UsdPrimValueSkeleton> skeleton = child->get_value();
+				const PackedStringArray joints = skeleton->get_joints();
+				for (int joint_idx = 0; joint_idx < joints.size(); joint_idx++) {
+					const CharString joint = joints[joint_idx].utf8();
+					hasher.add_buffer(joint.get_data(), joint.length());
 				}
-
-				surface_indices.push_back(surface_vertices.size() - 1);
+				const Vector<Transform3D> rest_transforms = skeleton->get_rest_transforms();
+				hasher.add_buffer(rest_transforms.ptr(), rest_transforms.size() * sizeof(Transform3D));
+				break;
 			}
-		}
-
-		if (has_uvs) {
-			Array uv_values = uv_primvar->get_values();
-			UsdGeomPrimvar::Interpolation interp = uv_primvar->get_interpolation();
-
-			if (interp == UsdGeomPrimvar::VERTEX) {
-				surface_uvs.resize(surface_vertices.size());
-
-				for (int i = 0; i < triangle_indices.size(); i++) {
-					int tri_idx = triangle_indices[i];
-					int base_idx = tri_idx * 3;
-
-					for (int j = 0; j < 3; j++) {
-						int vertex_index = triangulated_face_vertex_indices[base_idx + j];
-						int surface_idx = i * 3 + j;
-
-						if (vertex_index < uv_values.size()) {
-							Vector2 uv = uv_values[vertex_index];
-							uv.y = 1.0 - uv.y;
-							surface_uvs[surface_idx] = uv;
-						}
-					}
+			case UsdPrimType::USD_PRIM_TYPE_POINT_INSTANCER: {
+				const Ref<UsdPrimValuePointInstancer> instancer = child->get_value();
+				const Transform3D transform = instancer->get_transform();
+				hasher.add_buffer(&transform, sizeof(Transform3D));
+
+				const TypedArray<UsdPath> prototypes = instancer->get_prototypes();
+				hasher.add(prototypes.size());
+				for (int prototype_idx = 0; prototype_idx < prototypes.size(); prototype_idx++) {
+					const Ref<UsdPath> prototype = prototypes[prototype_idx];
+					hash_path(prototype, root_path, hasher);
 				}
-			} else if (interp == UsdGeomPrimvar::FACEVARYING) {
-				surface_uvs.resize(surface_vertices.size());
-
-				for (int i = 0; i < surface_indices.size(); i++) {
-					int orig_face_idx = triangulated_to_orig_face_vertex_index_map[i];
 
-					if (orig_face_idx < uv_values.size()) {
-						Vector2 uv = uv_values[orig_face_idx];
-						uv.y = 1.0 - uv.y;
-						surface_uvs[i] = uv;
-					}
-				}
+				const PackedInt32Array proto_indices = instancer->get_proto_indices();
+				const PackedVector3Array positions = instancer->get_positions();
+				const PackedVector4Array orientations = instancer->get_orientations();
+				const PackedVector3Array scales = instancer->get_scales();
+				hasher.add_buffer(proto_indices.ptr(), proto_indices.size() * sizeof(int32_t));
+				hasher.add_buffer(positions.ptr(), positions.size() * sizeof(Vector3));
+				hasher.add_buffer(orientations.ptr(), orientations.size() * sizeof(Vector4));
+				hasher.add_buffer(scales.ptr(), scales.size() * sizeof(Vector3));
+				break;
 			}
+			// Only grouping, or never converted to nodes. Materials are hashed as part of the meshes binding them
+			case UsdPrimType::USD_PRIM_TYPE_MODEL:
+			case UsdPrimType::USD_PRIM_TYPE_SKELETON_ROOT:
+			case UsdPrimType::USD_PRIM_TYPE_SCOPE:
+			case UsdPrimType::USD_PRIM_TYPE_MATERIAL:
+			case UsdPrimType::USD_PRIM_TYPE_SHADER:
+			case UsdPrimType::USD_PRIM_TYPE_GEOM_SUBSET:
+				break;
+			default:
+				return false;
 		}
 
-		if (has_skin) {
-			Array bone_values = bone_primvar->get_values();
-			Array weight_values = weight_primvar->get_values();
-			UsdGeomPrimvar::Interpolation bone_interp = bone_primvar->get_interpolation();
-			UsdGeomPrimvar::Interpolation weight_interp = weight_primvar->get_interpolation();
-
-			ERR_CONTINUE_MSG(bone_interp != UsdGeomPrimvar::VERTEX, "Bone primvar interpolation must be VERTEX");
-			ERR_CONTINUE_MSG(weight_interp != UsdGeomPrimvar::VERTEX, "Weight primvar interpolation must be VERTEX");
-
-			int skin_element_size = bone_primvar->get_element_size();
-			int godot_skin_element_size = skin_element_size >= 8 ? 8 : 4;
-
-			surface_bones.resize(surface_vertices.size() * godot_skin_element_size);
-			surface_weights.resize(surface_vertices.size() * godot_skin_element_size);
-
-			for (int i = 0; i < triangle_indices.size(); i++) {
-				int tri_idx = triangle_indices[i];
-				int base_idx = tri_idx * 3;
-
-				for (int j = 0; j < 3; j++) {
-					int vertex_index = triangulated_face_vertex_indices[base_idx + j];
-					int surface_idx = i * 3 + j;
-
-					if (vertex_index < bone_values.size()) {
-						Array bone_indices = bone_values[vertex_index];
-						Array bone_weights = weight_values[vertex_index];
-
-						for (int k = 0; k < godot_skin_element_size; k++) {
-							int bone_idx = -1;
-							real_t bone_weight = 0.0;
+		if (!hash_prototype_children(child, root_path, hasher)) {
+			return false;
+		}
+	}
+	return true;
+}
 
-							if (k < skin_element_size && k < bone_indices.size()) {
-								bone_idx = bone_indices[k];
-								bone_weight = bone_weights[k];
-							}
+// Transform of node relative to ancestor
+Transform3D get_relative_transform(const Node3D *node, const Node *ancestor) {
+	Transform3D transform;
+	while (node && node != ancestor) {
+		transform = node->get_transform() * transform;
+		node = Object::cast_to<Node3D>(node->get_parent());
+	}
+	return transform;
+}
 
-							surface_bones[surface_idx * godot_skin_element_size + k] = bone_idx;
-							surface_weights[surface_idx * godot_skin_element_size + k] = bone_weight;
-						}
-					}
-				}
-			}
-		}
+void find_mesh_instances(Node *node, Vector<ImporterMeshInstance3D *> &r_mesh_instances) {
+	ImporterMeshInstance3D *mesh_instance = Object::cast_to<ImporterMeshInstance3D>(node);
+	if (mesh_instance) {
+		r_mesh_instances.push_back(mesh_instance);
+	}
+	for (int i = 0; i < node->get_child_count(); i++) {
+		find_mesh_instances(node->get_child(i), r_mesh_instances);
+	}
+}
 
-		int64_t surface_flags = Mesh::ARRAY_FORMAT_VERTEX | Mesh::ARRAY_FORMAT_INDEX;
-		surface_arrays[Mesh::ARRAY_VERTEX] = surface_vertices;
-		surface_arrays[Mesh::ARRAY_INDEX] = surface_indices;
+// The first chunk goes into mesh_instance, the others become its children so each one is culled on its own
+void set_mesh_chunks(ImporterMeshInstance3D *mesh_instance, const Vector<Ref<ImporterMesh>> &meshes) {
+	if (meshes.is_empty()) {
+		return;
+	}
+	mesh_instance->set_mesh(meshes[0]);
+
+	for (int chunk_idx = 1; chunk_idx < meshes.size(); chunk_idx++) {
+		ImporterMeshInstance3D *chunk_instance = memnew(ImporterMeshInstance3D);
+		chunk_instance->set_name(meshes[chunk_idx]->get_name());
+		chunk_instance->set_mesh(meshes[chunk_idx]);
+		mesh_instance->add_child(chunk_instance);
+		chunk_instance->set_owner(get_owner(mesh_instance));
+	}
+}
 
-		if (!surface_normals.is_empty()) {
-			surface_flags |= Mesh::ARRAY_FORMAT_NORMAL;
-			surface_arrays[Mesh::ARRAY_NORMAL] = surface_normals;
-		}
+// Geometry keys are only hashes, so a hit is checked against the mesh the shared one was built from
+bool has_same_counts(const Ref<UsdPrimValueGeomMesh> &a, const Ref<UsdPrimValueGeomMesh> &b) {
+	return a->get_point_count() == b->get_point_count() && a->get_face_vertex_index_count() == b->get_face_vertex_index_count();
+}
 
-		if (!surface_uvs.is_empty()) {
-			surface_flags |= Mesh::ARRAY_FORMAT_TEX_UV;
-			surface_arrays[Mesh::ARRAY_TEX_UV] = surface_uvs;
-		}
+bool is_mesh_instance(const Ref<UsdPrim> &prim) {
+	//check if children are meshes
+	const TypedArray<UsdPrim> &children = prim->get_children();
+	if (children.size() != 1) {
+		return false;
+	}
+	const Ref<UsdPrim> &child = children[0];
+	return child->get_type() == UsdPrimType::USD_PRIM_TYPE_MESH;
+}
 
-		if (has_skin) {
-			surface_arrays[Mesh::ARRAY_BONES] = surface_bones;
-			surface_arrays[Mesh::ARRAY_WEIGHTS] = surface_weights;
+Ref<ImporterMesh> UsdGodotSceneConverter::convert_mesh(const Ref<UsdPrimValueGeomMesh> &geom_mesh, const Vector3::Axis up_axis) {
+	ERR_FAIL_COND_V_MSG(geom_mesh.is_null(), nullptr, "GeomMesh is null");
+	ERR_FAIL_COND_V_MSG(_materials.is_null(), nullptr, "Materials is null");
 
-			surface_flags |= Mesh::ARRAY_FORMAT_WEIGHTS;
-			surface_flags |= Mesh::ARRAY_FORMAT_BONES;
-			if (weight_primvar->get_element_size() > 4) {
-				surface_flags |= Mesh::ARRAY_FLAG_USE_8_BONE_WEIGHTS;
-			}
-		}
+	// A single mesh is returned, so it is never split into chunks
+	MeshBuildOptions options = _mesh_build_options;
+	options.chunk_triangle_count = 0;
+	options.chunk_extent = 0.0;
 
-		Ref<StandardMaterial3D> material = nullptr;
-		if (_materials.is_valid() && material_idx >= 0 && material_idx < material_paths.size()) {
-			Ref<UsdPath> material_path = material_paths[material_idx];
-			if (material_path.is_valid()) {
-				material = _materials->get_material_with_path(material_path);
-			}
-		}
+	MeshData mesh_data;
+	ERR_FAIL_COND_V(!build_mesh_data(geom_mesh, _materials, up_axis, options, &mesh_data), nullptr);
+	return create_importer_mesh(mesh_data);
+}
 
-		int surface_idx = mesh->get_surface_count();
-		String surface_name = surface_names.size() > material_idx ? surface_names[material_idx] : String();
-		Ref<StandardMaterial3D> godot_material = material.is_valid() ? material : nullptr;
-		mesh->add_surface(Mesh::PRIMITIVE_TRIANGLES, surface_arrays, {}, {}, godot_material, surface_name, surface_flags);
-	}
+Vector<Ref<ImporterMesh>> UsdGodotSceneConverter::_convert_mesh_chunks(const Ref<UsdPrimValueGeomMesh> &geom_mesh, const Vector3::Axis up_axis) {
+	ERR_FAIL_COND_V_MSG(_materials.is_null(), Vector<Ref<ImporterMesh>>(), "Materials is null");
 
-	return mesh;
+	MeshData mesh_data;
+	ERR_FAIL_COND_V(!build_mesh_data(geom_mesh, _materials, up_axis, _mesh_build_options, &mesh_data), Vector<Ref<ImporterMesh>>());
+	return create_importer_meshes(mesh_data);
 }
 
 Skeleton3D *UsdGodotSceneConverter::convert_skeleton(const Ref<UsdPrimValueSkeleton> &skeleton, const Vector3::Axis up_axis) {
@@ -312,6 +252,7 @@ Skeleton3D *UsdGodotSceneConverter::convert_skeleton(const Ref<UsdPrimValueSkele
 		String joint_name = joints[bone_idx];
 		Transform3D rest_transform = rest_transforms[bone_idx];
 		rest_transform.basis = apply_up_axis(rest_transform.basis, up_axis);
+		rest_transform.origin *= _mesh_build_options.unit_scale;
 
 		PackedStringArray path = joint_name.split("/");
 		String bone_name = path[path.size() - 1];
@@ -351,7 +292,7 @@ Node3D *UsdGodotSceneConverter::convert_xform(const Ref<UsdPrim> &xform_prim, No
 	Node3D *node = memnew(Node3D);
 
 	node->set_name(xform->get_name());
-	node->set_transform(apply_up_axis(xform->get_transform(), up_axis));
+	node->set_transform(_to_godot_transform(xform->get_transform(), up_axis));
 
 	if (parent) {
 		parent->add_child(node);
@@ -402,7 +343,7 @@ ImporterMeshInstance3D *UsdGodotSceneConverter::convert_mesh_instance(const Ref<
 	Ref<UsdPrimValueGeomMesh> geom_mesh;
 	if (mesh_instance_prim->get_type() == UsdPrimType::USD_PRIM_TYPE_XFORM) {
 		Ref<UsdPrimValueXform> xform = mesh_instance_prim->get_value();
-		mesh_instance->set_transform(apply_up_axis(xform->get_transform(), up_axis));
+		mesh_instance->set_transform(_to_godot_transform(xform->get_transform(), up_axis));
 
 		const TypedArray<UsdPrim> &children = mesh_instance_prim->get_children();
 		ERR_FAIL_COND_V_MSG(children.size() != 1, nullptr, "Expected one child for mesh instance");
@@ -426,11 +367,453 @@ ImporterMeshInstance3D *UsdGodotSceneConverter::convert_mesh_instance(const Ref<
 	}
 
 	mesh_instance->set_name(geom_mesh->get_name());
-	mesh_instance->set_mesh(convert_mesh(geom_mesh, up_axis));
+	const uint64_t geometry_key = _share_duplicate_meshes ? _get_geometry_key(geom_mesh, up_axis) : 0;
+
+	if (_build_meshes_in_parallel) {
+		PendingMesh pending = { geom_mesh, mesh_instance, up_axis };
+		if (_share_duplicate_meshes) {
+			HashMap<uint64_t, int>::Iterator existing = _shared_pending_meshes.find(geometry_key);
+			if (!existing) {
+				_shared_pending_meshes.insert(geometry_key, _pending_meshes.size());
+			} else if (has_same_counts(_pending_meshes[existing->value].geom_mesh, geom_mesh)) {
+				pending.source_idx = existing->value;
+			}
+		}
+		_pending_meshes.push_back(pending);
+	} else if (_share_duplicate_meshes) {
+		HashMap<uint64_t, SharedMesh>::Iterator existing = _shared_meshes.find(geometry_key);
+		if (existing && has_same_counts(existing->value.geom_mesh, geom_mesh)) {
+			set_mesh_chunks(mesh_instance, existing->value.meshes);
+		} else {
+			const Vector<Ref<ImporterMesh>> meshes = _convert_mesh_chunks(geom_mesh, up_axis);
+			if (!existing && !meshes.is_empty()) {
+				_shared_meshes.insert(geometry_key, { geom_mesh, meshes });
+			}
+			set_mesh_chunks(mesh_instance, meshes);
+		}
+	} else {
+		set_mesh_chunks(mesh_instance, _convert_mesh_chunks(geom_mesh, up_axis));
+	}
 
 	return mesh_instance;
 }
 
+Node3D *UsdGodotSceneConverter::convert_model(const Ref<UsdPrim> &model_prim, Node3D *parent, const Vector3::Axis up_axis) {
+	ERR_FAIL_COND_V(model_prim.is_null(), nullptr);
+
+	// Typeless prims have no transform of their own, they only group their children
+	Node3D *node = memnew(Node3D);
+	node->set_name(model_prim->get_name());
+
+	if (parent) {
+		parent->add_child(node);
+		node->set_owner(get_owner(parent));
+	}
+
+	convert_prim_children(model_prim, node, up_axis);
+
+	return node;
+}
+
+Node3D *UsdGodotSceneConverter::convert_instance(const Ref<UsdPrim> &instance_prim, Node3D *parent, const Vector3::Axis up_axis) {
+	ERR_FAIL_COND_V(instance_prim.is_null(), nullptr);
+
+	Node3D *node = memnew(Node3D);
+	node->set_name(instance_prim->get_name());
+	if (instance_prim->get_type() == UsdPrimType::USD_PRIM_TYPE_XFORM) {
+		Ref<UsdPrimValueXform> xform = instance_prim->get_value();
+		node->set_transform(_to_godot_transform(xform->get_transform(), up_axis));
+	}
+
+	if (parent) {
+		parent->add_child(node);
+		node->set_owner(get_owner(parent));
+	}
+
+	uint64_t prototype_key = 0;
+	if (!_get_prototype_key(instance_prim, up_axis, &prototype_key)) {
+		convert_prim_children(instance_prim, node, up_axis);
+		return node;
+	}
+
+	// Only the first instance of a prototype is converted, the others get copies of its nodes once the meshes are built
+	if (!_instance_prototypes.has(prototype_key)) {
+		_instance_prototypes.insert(prototype_key, node);
+		convert_prim_children(instance_prim, node, up_axis);
+	}
+	_pending_instances.push_back({ prototype_key, node });
+
+	return node;
+}
+
+bool UsdGodotSceneConverter::_get_prototype_key(const Ref<UsdPrim> &instance_prim, const Vector3::Axis up_axis, uint64_t *r_key) {
+	// tinyusdz composes every instance into its own copy of the prototype, so prototypes are told apart by their content
+	ContentHasher hasher;
+	hasher.add(up_axis);
+	if (!hash_prototype_children(instance_prim, instance_prim->get_path()->full_path(), hasher)) {
+		return false;
+	}
+	*r_key = hasher.get();
+	return true;
+}
+
+void UsdGodotSceneConverter::_resolve_pending_instances() {
+	if (_pending_instances.is_empty()) {
+		return;
+	}
+
+	// Instances of the same prototype under the same parent can become one MultiMeshInstance3D
+	HashMap<uint64_t, Vector<int>> instance_groups;
+	for (int i = 0; i < _pending_instances.size(); i++) {
+		const PendingInstance &instance = _pending_instances[i];
+		ContentHasher hasher;
+		hasher.add(instance.prototype_key);
+		hasher.add(uint64_t(reinterpret_cast<uintptr_t>(instance.node->get_parent())));
+		instance_groups[hasher.get()].push_back(i);
+	}
+
+	std::vector<uint8_t> collapsed(_pending_instances.size(), 0);
+	if (_multimesh_instance_threshold > 0) {
+		for (const KeyValue<uint64_t, Vector<int>> &group : instance_groups) {
+			const Vector<int> &instances = group.value;
+			Node *parent = _pending_instances[instances[0]].node->get_parent();
+			if (instances.size() < _multimesh_instance_threshold || !parent) {
+				continue;
+			}
+
+			const Node3D *prototype = _instance_prototypes[_pending_instances[instances[0]].prototype_key];
+			if (prototype->get_child_count() != 1) {
+				continue;
+			}
+
+			const ImporterMeshInstance3D *mesh_instance = Object::cast_to<ImporterMeshInstance3D>(prototype->get_child(0));
+			if (!mesh_instance || mesh_instance->get_child_count() > 0 || !mesh_instance->get_skeleton_path().is_empty() || mesh_instance->get_mesh().is_null()) {
+				continue;
+			}
+
+			Vector<Transform3D> transforms;
+			transforms.resize(instances.size());
+			for (int i = 0; i < instances.size(); i++) {
+				transforms.write[i] = _pending_instances[instances[i]].node->get_transform();
+				collapsed[instances[i]] = 1;
+			}
+
+			MultiMeshInstance3D *multimesh_instance = memnew(MultiMeshInstance3D);
+			multimesh_instance->set_name(mesh_instance->get_name());
+			multimesh_instance->set_multimesh(create_multimesh(mesh_instance->get_mesh()->get_mesh(), transforms, mesh_instance->get_transform()));
+			parent->add_child(multimesh_instance, true);
+			multimesh_instance->set_owner(get_owner(parent));
+		}
+	}
+
+	// Copy the prototypes before removing collapsed instances, one of them may be the prototype of another group
+	for (int i = 0; i < _pending_instances.size(); i++) {
+		const PendingInstance &instance = _pending_instances[i];
+		const Node3D *prototype = _instance_prototypes[instance.prototype_key];
+		if (collapsed[i] || instance.node == prototype) {
+			continue;
+		}
+
+		Node *owner = get_owner(instance.node);
+		for (int child_idx = 0; child_idx < prototype->get_child_count(); child_idx++) {
+			Node *copy = prototype->get_child(child_idx)->duplicate();
+			instance.node->add_child(copy);
+			set_owner_recursive(copy, owner);
+		}
+	}
+
+	for (int i = 0; i < _pending_instances.size(); i++) {
+		if (collapsed[i]) {
+			Node3D *node = _pending_instances[i].node;
+			node->get_parent()->remove_child(node);
+			memdelete(node);
+		}
+	}
+
+	_pending_instances.clear();
+	_instance_prototypes.clear();
+}
+
+Node3D *UsdGodotSceneConverter::convert_point_instancer(const Ref<UsdPrim> &instancer_prim, Node3D *parent, const Vector3::Axis up_axis) {
+	ERR_FAIL_COND_V(instancer_prim.is_null(), nullptr);
+	ERR_FAIL_COND_V(_stage.is_null(), nullptr);
+	const Ref<UsdPrimValuePointInstancer> instancer = instancer_prim->get_value();
+	ERR_FAIL_COND_V(instancer.is_null(), nullptr);
+
+	Node3D *node = memnew(Node3D);
+	node->set_name(instancer->get_name());
+	node->set_transform(_to_godot_transform(instancer->get_transform(), up_axis));
+
+	if (parent) {
+		parent->add_child(node);
+		node->set_owner(get_owner(parent));
+	}
+
+	// Prototypes are converted outside of the scene, their meshes only end up in the MultiMeshes
+	PendingPointInstancer pending;
+	pending.node = node;
+	pending.prototypes_root = memnew(Node3D);
+
+	const TypedArray<UsdPath> prototype_paths = instancer->get_prototypes();
+	for (int i = 0; i < prototype_paths.size(); i++) {
+		const Ref<UsdPrim> prototype = _stage->get_prim_at_path(prototype_paths[i]);
+		if (prototype.is_null() || !prototype->is_valid()) {
+			WARN_PRINT("Point instancer prototype not found: " + Ref<UsdPath>(prototype_paths[i])->full_path());
+			pending.prototype_nodes.push_back(nullptr);
+			continue;
+		}
+		pending.prototype_nodes.push_back(Object::cast_to<Node3D>(convert_prim(prototype, pending.prototypes_root, up_axis)));
+	}
+
+	pending.instance_transforms = _get_point_instance_transforms(instancer, prototype_paths.size(), up_axis);
+	_pending_point_instancers.push_back(pending);
+
+	return node;
+}
+
+Vector<Vector<Transform3D>> UsdGodotSceneConverter::_get_point_instance_transforms(const Ref<UsdPrimValuePointInstancer> &instancer, int prototype_count, const Vector3::Axis up_axis) const {
+	Vector<Vector<Transform3D>> transforms;
+	transforms.resize(prototype_count);
+
+	const PackedInt32Array proto_indices = instancer->get_proto_indices();
+	const PackedVector3Array positions = instancer->get_positions();
+	const PackedVector4Array orientations = instancer->get_orientations();
+	const PackedVector3Array scales = instancer->get_scales();
+	const int64_t instance_count = proto_indices.size();
+	ERR_FAIL_COND_V_MSG(positions.size() != instance_count, transforms, "Point instancer positions and protoIndices differ in size");
+
+	const bool has_orientations = orientations.size() == instance_count;
+	const bool has_scales = scales.size() == instance_count;
+	const int32_t *proto_indices_ptr = proto_indices.ptr();
+	const Vector3 *positions_ptr = positions.ptr();
+	const Vector4 *orientations_ptr = orientations.ptr();
+	const Vector3 *scales_ptr = scales.ptr();
+
+	// Counting sort by prototype, so every prototype gets one contiguous array to upload
+	std::vector<int64_t> counts(prototype_count, 0);
+	for (int64_t i = 0; i < instance_count; i++) {
+		if (proto_indices_ptr[i] >= 0 && proto_indices_ptr[i] < prototype_count) {
+			counts[proto_indices_ptr[i]]++;
+		}
+	}
+
+	std::vector<Transform3D *> write_ptrs(prototype_count);
+	for (int proto_idx = 0; proto_idx < prototype_count; proto_idx++) {
+		transforms.write[proto_idx].resize(counts[proto_idx]);
+		write_ptrs[proto_idx] = transforms.write[proto_idx].ptrw();
+	}
+
+	for (int64_t i = 0; i < instance_count; i++) {
+		const int32_t proto_idx = proto_indices_ptr[i];
+		if (proto_idx < 0 || proto_idx >= prototype_count) {
+			continue;
+		}
+
+		Basis basis;
+		if (has_orientations) {
+			const Vector4 &orientation = orientations_ptr[i];
+			basis = Basis(Quaternion(orientation.x, orientation.y, orientation.z, orientation.w).normalized());
+		}
+		if (has_scales) {
+			basis = basis.scaled_local(scales_ptr[i]);
+		}
+
+		*write_ptrs[proto_idx]++ = _to_godot_transform(Transform3D(basis, positions_ptr[i]), up_axis);
+	}
+
+	return transforms;
+}
+
+void UsdGodotSceneConverter::_resolve_pending_point_instancers() {
+	// Nested point instancers are inside the prototypes of the outer ones, so they have to be resolved first
+	for (int instancer_idx = _pending_point_instancers.size() - 1; instancer_idx >= 0; instancer_idx--) {
+		const PendingPointInstancer &pending = _pending_point_instancers[instancer_idx];
+		Node *owner = get_owner(pending.node);
+
+		for (int proto_idx = 0; proto_idx < pending.prototype_nodes.size(); proto_idx++) {
+			Node3D *prototype = pending.prototype_nodes[proto_idx];
+			const Vector<Transform3D> &transforms = pending.instance_transforms[proto_idx];
+			if (!prototype || transforms.is_empty()) {
+				continue;
+			}
+
+			// One MultiMesh per mesh of the prototype, skinned meshes can't be drawn that way
+			Vector<ImporterMeshInstance3D *> mesh_instances;
+			find_mesh_instances(prototype, mesh_instances);
+			for (ImporterMeshInstance3D *mesh_instance : mesh_instances) {
+				if (mesh_instance->get_mesh().is_null() || !mesh_instance->get_skeleton_path().is_empty()) {
+					continue;
+				}
+
+				MultiMeshInstance3D *multimesh_instance = memnew(MultiMeshInstance3D);
+				multimesh_instance->set_name(mesh_instances.size() == 1 ? String(prototype->get_name()) : String(prototype->get_name()) + "_" + mesh_instance->get_name());
+				multimesh_instance->set_multimesh(create_multimesh(mesh_instance->get_mesh()->get_mesh(), transforms, get_relative_transform(mesh_instance, pending.prototypes_root)));
+				pending.node->add_child(multimesh_instance, true);
+				multimesh_instance->set_owner(owner);
+			}
+		}
+
+		memdelete(pending.prototypes_root);
+	}
+
+	_pending_point_instancers.clear();
+}
+
+uint64_t UsdGodotSceneConverter::_get_geometry_key(const Ref<UsdPrimValueGeomMesh> &geom_mesh, const Vector3::Axis up_axis) const {
+	ContentHasher hasher;
+	hasher.add(uint64_t(geom_mesh->get_geometry_hash()));
+	hasher.add(up_axis);
+
+	const MeshBuildOptions &options = _mesh_build_options;
+	hasher.add(options.subdivision_level);
+	hasher.add(options.subdivision_lods);
+	hasher.add(options.generate_lods);
+	hasher.add(options.optimize_vertex_order);
+	hasher.add(options.chunk_triangle_count);
+	hasher.add_buffer(&options.chunk_extent, sizeof(options.chunk_extent));
+	hasher.add_buffer(&options.unit_scale, sizeof(options.unit_scale));
+	hasher.add_buffer(&options.normal_crease_angle, sizeof(options.normal_crease_angle));
+	return hasher.get();
+}
+
+void UsdGodotSceneConverter::_assign_subdivision_levels() {
+	struct SubdivCandidate {
+		PackedInt32Array face_vertex_counts;
+		real_t world_extent = 0.0;
+		int64_t triangle_count = 0;
+		int level = 0;
+	};
+
+	// Node transforms are read here, only the stage is read on the workers.
+	// Duplicates are built from their source, so they count towards its triangles and the largest scale of them all is used
+	std::vector<real_t> world_scales(_pending_meshes.size(), 0.0);
+	std::vector<int64_t> reference_counts(_pending_meshes.size(), 0);
+	for (int mesh_idx = 0; mesh_idx < _pending_meshes.size(); mesh_idx++) {
+		const PendingMesh &pending = _pending_meshes[mesh_idx];
+		const int source_idx = pending.source_idx >= 0 ? pending.source_idx : mesh_idx;
+		const Vector3 scale = get_relative_transform(pending.mesh_instance, nullptr).basis.get_scale().abs();
+		world_scales[source_idx] = MAX(world_scales[source_idx], scale[scale.max_axis_index()]);
+		reference_counts[source_idx]++;
+	}
+
+	std::vector<SubdivCandidate> candidates(_pending_meshes.size());
+	std::vector<uint8_t> subdividable(_pending_meshes.size(), 0);
+	parallel_for(_pending_meshes.size(), [&](uint32_t mesh_idx) {
+		const PendingMesh &pending = _pending_meshes[mesh_idx];
+		if (pending.source_idx >= 0) {
+			return;
+		}
+
+		SubdivCandidate &candidate = candidates[mesh_idx];
+		candidate.face_vertex_counts = pending.geom_mesh->get_face_vertex_counts();
+		candidate.triangle_count = get_subdivision_triangle_count(pending.geom_mesh, candidate.face_vertex_counts, 0) * reference_counts[mesh_idx];
+		if (!is_subdivision_mesh(pending.geom_mesh)) {
+			return;
+		}
+
+		const PackedVector3Array points = pending.geom_mesh->get_points();
+		if (points.is_empty()) {
+			return;
+		}
+		AABB bounds(points[0], Vector3());
+		for (const Vector3 &point : points) {
+			bounds.expand_to(point);
+		}
+		candidate.world_extent = bounds.size.length() * world_scales[mesh_idx];
+		subdividable[mesh_idx] = 1;
+	}, "Measure USD subdivision meshes");
+
+	int64_t total_triangles = 0;
+	for (const SubdivCandidate &candidate : candidates) {
+		total_triangles += candidate.triangle_count;
+	}
+
+	// Greedy refinement of the mesh with the longest estimated world space edges, which stands in for the screen space error
+	// since the camera isn't known at import. triangle_count covers all references, the edges are those of a single one
+	auto edge_length = [&](int mesh_idx) {
+		const SubdivCandidate &candidate = candidates[mesh_idx];
+		const int64_t mesh_triangles = candidate.triangle_count / reference_counts[mesh_idx];
+		return candidate.world_extent / Math::sqrt(real_t(MAX(mesh_triangles, int64_t(1))));
+	};
+	std::priority_queue<std::pair<real_t, int>> queue;
+	for (int mesh_idx = 0; mesh_idx < _pending_meshes.size(); mesh_idx++) {
+		if (subdividable[mesh_idx]) {
+			queue.push({ edge_length(mesh_idx), mesh_idx });
+		}
+	}
+
+	const int max_level = _mesh_build_options.subdivision_level;
+	while (!queue.empty()) {
+		const int mesh_idx = queue.top().second;
+		queue.pop();
+
+		SubdivCandidate &candidate = candidates[mesh_idx];
+		const int64_t refined_triangles = get_subdivision_triangle_count(_pending_meshes[mesh_idx].geom_mesh, candidate.face_vertex_counts, candidate.level + 1) * reference_counts[mesh_idx];
+		if (total_triangles - candidate.triangle_count + refined_triangles > _subdivision_triangle_budget) {
+			continue;
+		}
+
+		total_triangles += refined_triangles - candidate.triangle_count;
+		candidate.triangle_count = refined_triangles;
+		candidate.level++;
+		if (candidate.level < max_level) {
+			queue.push({ edge_length(mesh_idx), mesh_idx });
+		}
+	}
+
+	for (int mesh_idx = 0; mesh_idx < _pending_meshes.size(); mesh_idx++) {
+		if (subdividable[mesh_idx]) {
+			_pending_meshes.write[mesh_idx].subdivision_level = candidates[mesh_idx].level;
+		}
+	}
+}
+
+void UsdGodotSceneConverter::build_pending_meshes() {
+	if (_pending_meshes.is_empty()) {
+		_resolve_pending_instances();
+		_resolve_pending_point_instancers();
+		return;
+	}
+	ERR_FAIL_COND_MSG(_materials.is_null(), "Materials is null");
+
+	if (_mesh_build_options.subdivision_level > 0 && _subdivision_triangle_budget > 0) {
+		_assign_subdivision_levels();
+	}
+
+	// Meshes are independent of each other, only the ImporterMesh creation below has to be serial
+	std::vector<MeshData> mesh_data(_pending_meshes.size());
+	std::vector<uint8_t> built(_pending_meshes.size(), 0);
+	parallel_for(_pending_meshes.size(), [&](uint32_t mesh_idx) {
+		const PendingMesh &pending = _pending_meshes[mesh_idx];
+		if (pending.source_idx < 0) {
+			MeshBuildOptions options = _mesh_build_options;
+			if (pending.subdivision_level >= 0) {
+				options.subdivision_level = pending.subdivision_level;
+			}
+			built[mesh_idx] = build_mesh_data(pending.geom_mesh, _materials, pending.up_axis, options, &mesh_data[mesh_idx]);
+		}
+	}, "Build USD meshes");
+
+	// Duplicates always come after their source, so the source mesh already exists when they are reached
+	std::vector<Vector<Ref<ImporterMesh>>> meshes(_pending_meshes.size());
+	for (int mesh_idx = 0; mesh_idx < _pending_meshes.size(); mesh_idx++) {
+		const PendingMesh &pending = _pending_meshes[mesh_idx];
+		if (pending.source_idx >= 0) {
+			meshes[mesh_idx] = meshes[pending.source_idx];
+		} else if (built[mesh_idx]) {
+			meshes[mesh_idx] = create_importer_meshes(mesh_data[mesh_idx]);
+		}
+
+		set_mesh_chunks(pending.mesh_instance, meshes[mesh_idx]);
+	}
+
+	_pending_meshes.clear();
+	_shared_pending_meshes.clear();
+
+	_resolve_pending_instances();
+	_resolve_pending_point_instancers();
+}
+
 void UsdGodotSceneConverter::convert_prim_children(const Ref<UsdPrim> &prim, Node3D *parent, const Vector3::Axis up_axis) {
 	ERR_FAIL_COND(prim.is_null());
 
@@ -445,21 +828,38 @@ Node *UsdGodotSceneConverter::convert_prim(const Ref<UsdPrim> &prim, Node3D *par
 
 	switch (prim->get_type()) {
 		case UsdPrimType::USD_PRIM_TYPE_XFORM:
+			if (prim->is_instanceable()) {
+				return convert_instance(prim, parent, up_axis);
+			}
 			return convert_xform(prim, parent, up_axis);
+		case UsdPrimType::USD_PRIM_TYPE_MODEL:
+			if (prim->is_instanceable()) {
+				return convert_instance(prim, parent, up_axis);
+			}
+			return convert_model(prim, parent, up_axis);
+		case UsdPrimType::USD_PRIM_TYPE_POINT_INSTANCER:
+			return convert_point_instancer(prim, parent, up_axis);
 		case UsdPrimType::USD_PRIM_TYPE_SKELETON_ROOT:
 			return convert_skeleton_root(prim, parent, up_axis);
 		case UsdPrimType::USD_PRIM_TYPE_MESH:
-			return convert_mesh_instance(prim->get_value(), parent, up_axis);
+			return convert_mesh_instance(prim, parent, up_axis);
 
 		default:
 			ERR_FAIL_V_MSG(nullptr, "Failed to convert prim of type: " + prim->get_type_name());
 	}
 }
 
+Transform3D UsdGodotSceneConverter::_to_godot_transform(const Transform3D &transform, const Vector3::Axis up_axis) const {
+	Transform3D result = apply_up_axis(transform, up_axis);
+	result.origin *= _mesh_build_options.unit_scale;
+	return result;
+}
+
 bool UsdGodotSceneConverter::load(const Ref<UsdStage> &stage) {
 	ERR_FAIL_COND_V(stage.is_null(), false);
 	_stage = stage;
 	_materials = _stage->extract_materials();
+	_shared_meshes.clear();
 	return true;
 }
 
@@ -472,11 +872,40 @@ UsdGodotSceneConverter::~UsdGodotSceneConverter() {
 void UsdGodotSceneConverter::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("load", "stage"), &UsdGodotSceneConverter::load);
 
+	ClassDB::bind_method(D_METHOD("set_build_meshes_in_parallel", "enabled"), &UsdGodotSceneConverter::set_build_meshes_in_parallel);
+	ClassDB::bind_method(D_METHOD("get_build_meshes_in_parallel"), &UsdGodotSceneConverter::get_build_meshes_in_parallel);
+	ClassDB::bind_method(D_METHOD("build_pending_meshes"), &UsdGodotSceneConverter::build_pending_meshes);
+	ClassDB::bind_method(D_METHOD("set_share_duplicate_meshes", "enabled"), &UsdGodotSceneConverter::set_share_duplicate_meshes);
+	ClassDB::bind_method(D_METHOD("get_share_duplicate_meshes"), &UsdGodotSceneConverter::get_share_duplicate_meshes);
+	ClassDB::bind_method(D_METHOD("set_subdivision_level", "level"), &UsdGodotSceneConverter::set_subdivision_level);
+	ClassDB::bind_method(D_METHOD("get_subdivision_level"), &UsdGodotSceneConverter::get_subdivision_level);
+	ClassDB::bind_method(D_METHOD("set_subdivision_triangle_budget", "budget"), &UsdGodotSceneConverter::set_subdivision_triangle_budget);
+	ClassDB::bind_method(D_METHOD("get_subdivision_triangle_budget"), &UsdGodotSceneConverter::get_subdivision_triangle_budget);
+	ClassDB::bind_method(D_METHOD("set_subdivision_lods", "enabled"), &UsdGodotSceneConverter::set_subdivision_lods);
+	ClassDB::bind_method(D_METHOD("get_subdivision_lods"), &UsdGodotSceneConverter::get_subdivision_lods);
+	ClassDB::bind_method(D_METHOD("set_generate_lods", "enabled"), &UsdGodotSceneConverter::set_generate_lods);
+	ClassDB::bind_method(D_METHOD("get_generate_lods"), &UsdGodotSceneConverter::get_generate_lods);
+	ClassDB::bind_method(D_METHOD("set_optimize_vertex_order", "enabled"), &UsdGodotSceneConverter::set_optimize_vertex_order);
+	ClassDB::bind_method(D_METHOD("get_optimize_vertex_order"), &UsdGodotSceneConverter::get_optimize_vertex_order);
+	ClassDB::bind_method(D_METHOD("set_unit_scale", "scale"), &UsdGodotSceneConverter::set_unit_scale);
+	ClassDB::bind_method(D_METHOD("get_unit_scale"), &UsdGodotSceneConverter::get_unit_scale);
+	ClassDB::bind_method(D_METHOD("set_chunk_triangle_count", "count"), &UsdGodotSceneConverter::set_chunk_triangle_count);
+	ClassDB::bind_method(D_METHOD("get_chunk_triangle_count"), &UsdGodotSceneConverter::get_chunk_triangle_count);
+	ClassDB::bind_method(D_METHOD("set_chunk_extent", "extent"), &UsdGodotSceneConverter::set_chunk_extent);
+	ClassDB::bind_method(D_METHOD("get_chunk_extent"), &UsdGodotSceneConverter::get_chunk_extent);
+	ClassDB::bind_method(D_METHOD("set_normal_crease_angle", "degrees"), &UsdGodotSceneConverter::set_normal_crease_angle);
+	ClassDB::bind_method(D_METHOD("get_normal_crease_angle"), &UsdGodotSceneConverter::get_normal_crease_angle);
+	ClassDB::bind_method(D_METHOD("set_multimesh_instance_threshold", "threshold"), &UsdGodotSceneConverter::set_multimesh_instance_threshold);
+	ClassDB::bind_method(D_METHOD("get_multimesh_instance_threshold"), &UsdGodotSceneConverter::get_multimesh_instance_threshold);
+
 	ClassDB::bind_method(D_METHOD("convert_mesh", "geom_mesh", "up_axis"), &UsdGodotSceneConverter::convert_mesh, DEFVAL(DEFAULT_UP_AXIS));
 	ClassDB::bind_method(D_METHOD("convert_skeleton", "skeleton", "up_axis"), &UsdGodotSceneConverter::convert_skeleton, DEFVAL(DEFAULT_UP_AXIS));
 	ClassDB::bind_method(D_METHOD("convert_xform", "xform", "parent", "up_axis"), &UsdGodotSceneConverter::convert_xform, DEFVAL(nullptr), DEFVAL(DEFAULT_UP_AXIS));
 	ClassDB::bind_method(D_METHOD("convert_skeleton_root", "skeleton_root_prim", "parent", "up_axis"), &UsdGodotSceneConverter::convert_skeleton_root, DEFVAL(nullptr), DEFVAL(DEFAULT_UP_AXIS));
 	ClassDB::bind_method(D_METHOD("convert_mesh_instance", "geom_mesh", "parent", "up_axis"), &UsdGodotSceneConverter::convert_mesh_instance, DEFVAL(nullptr), DEFVAL(DEFAULT_UP_AXIS));
+	ClassDB::bind_method(D_METHOD("convert_model", "model_prim", "parent", "up_axis"), &UsdGodotSceneConverter::convert_model, DEFVAL(nullptr), DEFVAL(DEFAULT_UP_AXIS));
+	ClassDB::bind_method(D_METHOD("convert_instance", "instance_prim", "parent", "up_axis"), &UsdGodotSceneConverter::convert_instance, DEFVAL(nullptr), DEFVAL(DEFAULT_UP_AXIS));
+	ClassDB::bind_method(D_METHOD("convert_point_instancer", "instancer_prim", "parent", "up_axis"), &UsdGodotSceneConverter::convert_point_instancer, DEFVAL(nullptr), DEFVAL(DEFAULT_UP_AXIS));
 	ClassDB::bind_method(D_METHOD("convert_prim_children", "prim", "parent", "up_axis"), &UsdGodotSceneConverter::convert_prim_children, DEFVAL(nullptr), DEFVAL(DEFAULT_UP_AXIS));
 	ClassDB::bind_method(D_METHOD("convert_prim", "prim", "parent", "up_axis"), &UsdGodotSceneConverter::convert_prim, DEFVAL(nullptr), DEFVAL(DEFAULT_UP_AXIS));
 }
@@ -6,7 +6,9 @@
 #include <godot_cpp/classes/packed_scene.hpp>
 #include <godot_cpp/classes/ref_counted.hpp>
 #include <godot_cpp/classes/skeleton3d.hpp>
+#include <godot_cpp/templates/hash_map.hpp>
 
+#include "convert/mesh_builder.h"
 #include "usd/usd_geom.h"
 #include "usd/usd_prim.h"
 #include "usd/usd_stage.h"
@@ -18,6 +20,67 @@ private:
 	godot::Ref<UsdStage> _stage;
 	godot::Ref<UsdLoadedMaterials> _materials;
 
+	struct PendingMesh {
+		godot::Ref<UsdPrimValueGeomMesh> geom_mesh;
+		godot::ImporterMeshInstance3D *mesh_instance = nullptr;
+		godot::Vector3::Axis up_axis = godot::Vector3::AXIS_Y;
+		// Index of the earlier pending mesh with the same geometry, -1 if this one has to be built
+		int source_idx = -1;
+		// Chosen by the triangle budget, -1 uses the subdivision level of the build options
+		int subdivision_level = -1;
+	};
+
+	bool _build_meshes_in_parallel = false;
+	godot::Vector<PendingMesh> _pending_meshes;
+
+	MeshBuildOptions _mesh_build_options;
+	int64_t _subdivision_triangle_budget = 0;
+
+	void _assign_subdivision_levels();
+
+	bool _share_duplicate_meshes = true;
+	struct SharedMesh {
+		// The mesh the meshes were built from, a key hit is checked against it
+		godot::Ref<UsdPrimValueGeomMesh> geom_mesh;
+		godot::Vector<godot::Ref<godot::ImporterMesh>> meshes;
+	};
+	// Geometry key to the converted mesh, or to the pending mesh index when building in parallel
+	godot::HashMap<uint64_t, SharedMesh> _shared_meshes;
+	godot::HashMap<uint64_t, int> _shared_pending_meshes;
+
+	// One mesh per spatial chunk, see set_chunk_triangle_count
+	godot::Vector<godot::Ref<godot::ImporterMesh>> _convert_mesh_chunks(const godot::Ref<UsdPrimValueGeomMesh> &geom_mesh, const godot::Vector3::Axis up_axis);
+	godot::Transform3D _to_godot_transform(const godot::Transform3D &transform, const godot::Vector3::Axis up_axis) const;
+	// Includes the build options, so meshes built before an option changed aren't shared afterwards
+	uint64_t _get_geometry_key(const godot::Ref<UsdPrimValueGeomMesh> &geom_mesh, const godot::Vector3::Axis up_axis) const;
+
+	struct PendingInstance {
+		uint64_t prototype_key = 0;
+		godot::Node3D *node = nullptr;
+	};
+
+	// Prototype key to the first instance, whose children are the converted prototype all other instances copy
+	godot::HashMap<uint64_t, godot::Node3D *> _instance_prototypes;
+	godot::Vector<PendingInstance> _pending_instances;
+	int _multimesh_instance_threshold = 64;
+
+	// Returns false if the prototype has prims whose content isn't hashed, those instances are converted on their own
+	static bool _get_prototype_key(const godot::Ref<UsdPrim> &instance_prim, const godot::Vector3::Axis up_axis, uint64_t *r_key);
+	void _resolve_pending_instances();
+
+	struct PendingPointInstancer {
+		godot::Node3D *node = nullptr;
+		// Holds the converted prototypes until their meshes are built, not part of the scene
+		godot::Node3D *prototypes_root = nullptr;
+		godot::Vector<godot::Node3D *> prototype_nodes;
+		godot::Vector<godot::Vector<godot::Transform3D>> instance_transforms;
+	};
+
+	godot::Vector<PendingPointInstancer> _pending_point_instancers;
+
+	godot::Vector<godot::Vector<godot::Transform3D>> _get_point_instance_transforms(const godot::Ref<UsdPrimValuePointInstancer> &instancer, int prototype_count, const godot::Vector3::Axis up_axis) const;
+	void _resolve_pending_point_instancers();
+
 protected:
 	static void _bind_methods();
 
@@ -26,12 +89,71 @@ public:
 	~UsdGodotSceneConverter();
 	bool load(const godot::Ref<UsdStage> &stage);
 
+	/// If enabled, mesh instances are created without a mesh and the meshes are only built
+	/// by build_pending_meshes, all of them at once on the WorkerThreadPool.
+	/// build_pending_meshes also fills in the instances of instanceable prims and point instancers, so call it after converting in both modes
+	void set_build_meshes_in_parallel(bool enabled) { _build_meshes_in_parallel = enabled; }
+	bool get_build_meshes_in_parallel() const { return _build_meshes_in_parallel; }
+	void build_pending_meshes();
+
+	/// If enabled, mesh prims with identical geometry, primvars and material bindings share one ImporterMesh
+	void set_share_duplicate_meshes(bool enabled) { _share_duplicate_meshes = enabled; }
+	bool get_share_duplicate_meshes() const { return _share_duplicate_meshes; }
+
+	/// Scale of mesh points and of node, bone and instance positions, e.g. UsdStage.get_meters_per_unit to import in meters
+	void set_unit_scale(real_t scale) { _mesh_build_options.unit_scale = scale; }
+	real_t get_unit_scale() const { return _mesh_build_options.unit_scale; }
+
+	/// Uniform subdivision level applied to meshes with a subdivisionScheme other than none, 0 imports the cage as is
+	void set_subdivision_level(int level) { _mesh_build_options.subdivision_level = level; }
+	int get_subdivision_level() const { return _mesh_build_options.subdivision_level; }
+
+	/// Triangles all meshes built by build_pending_meshes may add up to. Subdivision meshes then get their own level up to the subdivision level,
+	/// spent first where the world space edges are longest. 0 refines every mesh to the subdivision level.
+	/// Only meshes built by build_pending_meshes are counted, so the budget has no effect unless meshes are built in parallel
+	void set_subdivision_triangle_budget(int64_t budget) { _subdivision_triangle_budget = budget; }
+	int64_t get_subdivision_triangle_budget() const { return _subdivision_triangle_budget; }
+
+	/// If enabled, the coarser subdivision levels become LODs of the refined meshes
+	void set_subdivision_lods(bool enabled) { _mesh_build_options.subdivision_lods = enabled; }
+	bool get_subdivision_lods() const { return _mesh_build_options.subdivision_lods; }
+
+	/// If enabled, every surface gets a LOD chain by quadric simplification of its welded triangles
+	void set_generate_lods(bool enabled) { _mesh_build_options.generate_lods = enabled; }
+	bool get_generate_lods() const { return _mesh_build_options.generate_lods; }
+
+	/// If enabled, the triangles of every surface and its LODs are reordered for the vertex cache and overdraw, and the vertices for fetch locality
+	void set_optimize_vertex_order(bool enabled) { _mesh_build_options.optimize_vertex_order = enabled; }
+	bool get_optimize_vertex_order() const { return _mesh_build_options.optimize_vertex_order; }
+
+	/// Unskinned meshes with more triangles than this are split into grid chunks of about this many triangles, so each chunk is culled on its own.
+	/// The first chunk stays in the mesh instance and the others become its children. 0 disables this
+	void set_chunk_triangle_count(int64_t count) { _mesh_build_options.chunk_triangle_count = count; }
+	int64_t get_chunk_triangle_count() const { return _mesh_build_options.chunk_triangle_count; }
+	/// Unskinned meshes larger than this along any axis are split into grid chunks at most this large. 0 disables this
+	void set_chunk_extent(float extent) { _mesh_build_options.chunk_extent = extent; }
+	float get_chunk_extent() const { return _mesh_build_options.chunk_extent; }
+
+	/// Meshes without usable normals get generated ones, smoothed only across edges whose faces are at most this many degrees apart
+	void set_normal_crease_angle(float degrees) { _mesh_build_options.normal_crease_angle = degrees; }
+	float get_normal_crease_angle() const { return _mesh_build_options.normal_crease_angle; }
+
+	/// Instances of one prototype with the same parent are collapsed into a MultiMeshInstance3D once there are at least this many,
+	/// if the prototype is a single unskinned mesh. 0 disables this
+	void set_multimesh_instance_threshold(int threshold) { _multimesh_instance_threshold = threshold; }
+	int get_multimesh_instance_threshold() const { return _multimesh_instance_threshold; }
+
+	/// Never split into chunks
 	godot::Ref<godot::ImporterMesh> convert_mesh(const godot::Ref<UsdPrimValueGeomMesh> &geom_mesh, const godot::Vector3::Axis up_axis);
 
 	godot::Skeleton3D *convert_skeleton(const godot::Ref<UsdPrimValueSkeleton> &skeleton, const godot::Vector3::Axis up_axis);
 	godot::Node3D *convert_xform(const godot::Ref<UsdPrim> &xform, godot::Node3D *parent, const godot::Vector3::Axis up_axis);
 	godot::Skeleton3D *convert_skeleton_root(const godot::Ref<UsdPrim> &skeleton_root_prim, godot::Node3D *parent, const godot::Vector3::Axis up_axis);
 	godot::ImporterMeshInstance3D *convert_mesh_instance(const godot::Ref<UsdPrim> &mesh_instance_prim, godot::Node3D *parent, const godot::Vector3::Axis up_axis);
+	godot::Node3D *convert_model(const godot::Ref<UsdPrim> &model_prim, godot::Node3D *parent, const godot::Vector3::Axis up_axis);
+	godot::Node3D *convert_instance(const godot::Ref<UsdPrim> &instance_prim, godot::Node3D *parent, const godot::Vector3::Axis up_axis);
+	/// Emits one MultiMeshInstance3D per prototype mesh once build_pending_meshes is called
+	godot::Node3D *convert_point_instancer(const godot::Ref<UsdPrim> &instancer_prim, godot::Node3D *parent, const godot::Vector3::Axis up_axis);
 
 	void convert_prim_children(const godot::Ref<UsdPrim> &prim, godot::Node3D *parent, const godot::Vector3::Axis up_axis);
 
@@ -0,0 +1,822 @@
+#include "convert/mesh_builder.h"
+
+#include <godot_cpp/classes/mesh.hpp>
+#include <godot_cpp/templates/hash_map.hpp>
+#include <godot_cpp/templates/hashfuncs.hpp>
+#include <godot_cpp/variant/packed_color_array.hpp>
+#include <godot_cpp/variant/packed_float32_array.hpp>
+#include <godot_cpp/variant/packed_int64_array.hpp>
+#include <godot_cpp/variant/packed_string_array.hpp>
+#include <godot_cpp/variant/packed_vector2_array.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "utils/geom_utils.h"
+#include "utils/normal_utils.h"
+#include "utils/optimize_utils.h"
+#include "utils/simplify_utils.h"
+#include "utils/skin_utils.h"
+#include "utils/subdiv_utils.h"
+#include "utils/tangent_utils.h"
+#include "utils/thread_utils.h"
+
+using namespace godot;
+
+struct VertexKey {
+	int32_t point = -1;
+	Vector2 uv;
+	Vector3 normal;
+
+	bool operator==(const VertexKey &other) const {
+		return point == other.point && uv == other.uv && normal == other.normal;
+	}
+};
+
+struct VertexKeyHasher {
+	static _FORCE_INLINE_ uint32_t hash(const VertexKey &key) {
+		uint32_t h = hash_murmur3_one_32(key.point);
+		h = hash_murmur3_one_real(key.uv.x, h);
+		h = hash_murmur3_one_real(key.uv.y, h);
+		h = hash_murmur3_one_real(key.normal.x, h);
+		h = hash_murmur3_one_real(key.normal.y, h);
+		h = hash_murmur3_one_real(key.normal.z, h);
+		return hash_fmix32(h);
+	}
+};
+
+// Faces of a coarser subdivision level triangulated for one LOD, drawn with the points of the refined mesh
+struct SubdivLod {
+	PackedInt32Array triangle_points;
+	PackedInt32Array triangle_face_counts;
+	PackedInt32Array face_material_indices;
+	float edge_length = 0.0;
+};
+
+static float get_mean_edge_length(const PackedVector3Array &points, const PackedInt32Array &face_vertex_counts, const PackedInt32Array &face_vertex_indices) {
+	double length_sum = 0.0;
+	int64_t edge_count = 0;
+	int64_t face_start = 0;
+	for (const int32_t count : face_vertex_counts) {
+		for (int32_t corner = 0; corner < count; corner++) {
+			const int32_t a = face_vertex_indices[face_start + corner];
+			const int32_t b = face_vertex_indices[face_start + (corner + 1) % count];
+			length_sum += points[a].distance_to(points[b]);
+			edge_count++;
+		}
+		face_start += count;
+	}
+	return edge_count > 0 ? float(length_sum / edge_count) : 0.0f;
+}
+
+static SubdivScheme to_subdiv_scheme(UsdPrimValueGeomMesh::SubdivisionScheme scheme) {
+	switch (scheme) {
+		case UsdPrimValueGeomMesh::SUBDIVISION_SCHEME_LOOP:
+			return SubdivScheme::LOOP;
+		case UsdPrimValueGeomMesh::SUBDIVISION_SCHEME_BILINEAR:
+			return SubdivScheme::BILINEAR;
+		default:
+			return SubdivScheme::CATMULL_CLARK;
+	}
+}
+
+// Vertex i of the result is vertex sources[i] of array, which may hold several elements per vertex like bones and weights
+template <typename T>
+static T gather_vertex_array(const T &array, int64_t vertex_count, const std::vector<int32_t> &sources) {
+	const int64_t stride = vertex_count > 0 ? array.size() / vertex_count : 0;
+	T gathered;
+	gathered.resize(int64_t(sources.size()) * stride);
+	const auto *src = array.ptr();
+	auto *dst = gathered.ptrw();
+	for (size_t vertex = 0; vertex < sources.size(); vertex++) {
+		std::copy_n(src + int64_t(sources[vertex]) * stride, stride, dst + int64_t(vertex) * stride);
+	}
+	return gathered;
+}
+
+// Gathers every per vertex array of a surface, the index array is left to the caller
+static Array gather_vertex_arrays(const Array &arrays, int64_t vertex_count, const std::vector<int32_t> &sources) {
+	Array gathered;
+	gathered.resize(Mesh::ARRAY_MAX);
+	for (int array_idx = 0; array_idx < Mesh::ARRAY_MAX; array_idx++) {
+		if (array_idx == Mesh::ARRAY_INDEX) {
+			continue;
+		}
+		const Variant array = arrays[array_idx];
+		switch (array.get_type()) {
+			case Variant::PACKED_VECTOR3_ARRAY:
+				gathered[array_idx] = gather_vertex_array(PackedVector3Array(array), vertex_count, sources);
+				break;
+			case Variant::PACKED_VECTOR2_ARRAY:
+				gathered[array_idx] = gather_vertex_array(PackedVector2Array(array), vertex_count, sources);
+				break;
+			case Variant::PACKED_FLOAT32_ARRAY:
+				gathered[array_idx] = gather_vertex_array(PackedFloat32Array(array), vertex_count, sources);
+				break;
+			case Variant::PACKED_INT32_ARRAY:
+				gathered[array_idx] = gather_vertex_array(PackedInt32Array(array), vertex_count, sources);
+				break;
+			case Variant::PACKED_COLOR_ARRAY:
+				gathered[array_idx] = gather_vertex_array(PackedColorArray(array), vertex_count, sources);
+				break;
+			default:
+				break;
+		}
+	}
+	return gathered;
+}
+
+static PackedInt32Array remap_indices(const PackedInt32Array &indices, const std::vector<int32_t> &remap) {
+	PackedInt32Array remapped;
+	remapped.resize(indices.size());
+	int32_t *remapped_ptr = remapped.ptrw();
+	for (int64_t i = 0; i < indices.size(); i++) {
+		remapped_ptr[i] = remap[indices[i]];
+	}
+	return remapped;
+}
+
+// Reorders the triangles of the surface and its LODs for the vertex cache, then stores the vertices in the order they are fetched
+static void optimize_surface(MeshSurfaceData &surface) {
+	const PackedVector3Array vertices = surface.arrays[Mesh::ARRAY_VERTEX];
+	PackedInt32Array indices = surface.arrays[Mesh::ARRAY_INDEX];
+	optimize_vertex_cache(indices, vertices.size(), vertices);
+
+	std::vector<int32_t> remap;
+	get_vertex_fetch_remap(indices, vertices.size(), remap);
+	std::vector<int32_t> sources(remap.size());
+	for (size_t vertex = 0; vertex < remap.size(); vertex++) {
+		sources[remap[vertex]] = int32_t(vertex);
+	}
+	surface.arrays = gather_vertex_arrays(surface.arrays, vertices.size(), sources);
+	surface.arrays[Mesh::ARRAY_INDEX] = remap_indices(indices, remap);
+
+	Dictionary lods;
+	const Array lod_keys = surface.lods.keys();
+	for (int i = 0; i < lod_keys.size(); i++) {
+		PackedInt32Array lod_indices = surface.lods[lod_keys[i]];
+		optimize_vertex_cache(lod_indices, vertices.size());
+		lods[lod_keys[i]] = remap_indices(lod_indices, remap);
+	}
+	surface.lods = lods;
+}
+
+// Triangles of one surface that fall into each chunk, for the surface itself and for each of its LODs
+struct SurfaceChunkTriangles {
+	std::vector<std::vector<int32_t>> triangles;
+	std::vector<std::vector<std::vector<int32_t>>> lod_triangles;
+};
+
+// Splits the surfaces into the cells of a grid by triangle centroid. Every chunk keeps one surface per material it contains,
+// LOD triangles go with the chunk of their cell and are dropped where the chunk has none of the surface's full detail triangles
+static void split_mesh_chunks(MeshData &r_mesh, const MeshBuildOptions &options) {
+	int64_t triangle_count = 0;
+	AABB bounds;
+	bool has_bounds = false;
+	for (const MeshSurfaceData &surface : r_mesh.surfaces) {
+		const PackedVector3Array vertices = surface.arrays[Mesh::ARRAY_VERTEX];
+		triangle_count += PackedInt32Array(surface.arrays[Mesh::ARRAY_INDEX]).size() / 3;
+		for (const Vector3 &vertex : vertices) {
+			if (has_bounds) {
+				bounds.expand_to(vertex);
+			} else {
+				bounds = AABB(vertex, Vector3());
+				has_bounds = true;
+			}
+		}
+	}
+
+	const real_t max_extent = bounds.get_longest_axis_size();
+	real_t cell_size = Math_INF;
+	if (options.chunk_triangle_count > 0 && triangle_count > options.chunk_triangle_count) {
+		// Cells are cubes, flat meshes like terrain are only divided along their large axes
+		const int64_t cell_count = (triangle_count + options.chunk_triangle_count - 1) / options.chunk_triangle_count;
+		real_t volume = 1.0;
+		int dimensions = 0;
+		for (int axis = 0; axis < 3; axis++) {
+			if (bounds.size[axis] > max_extent * 0.01) {
+				volume *= bounds.size[axis];
+				dimensions++;
+			}
+		}
+		cell_size = Math::pow(volume / real_t(cell_count), real_t(1.0) / real_t(dimensions));
+	}
+	if (options.chunk_extent > 0.0 && max_extent > options.chunk_extent) {
+		cell_size = MIN(cell_size, real_t(options.chunk_extent));
+	}
+	if (!std::isfinite(cell_size) || cell_size <= 0.0) {
+		return;
+	}
+
+	int64_t cells[3];
+	for (int axis = 0; axis < 3; axis++) {
+		cells[axis] = MAX(int64_t(Math::ceil(bounds.size[axis] / cell_size)), int64_t(1));
+	}
+	if (cells[0] * cells[1] * cells[2] == 1) {
+		return;
+	}
+
+	auto triangle_cell = [&](const Vector3 *vertices, const int32_t *triangle) {
+		const Vector3 centroid = (vertices[triangle[0]] + vertices[triangle[1]] + vertices[triangle[2]]) / 3.0 - bounds.position;
+		int64_t cell[3];
+		for (int axis = 0; axis < 3; axis++) {
+			cell[axis] = CLAMP(int64_t(centroid[axis] / cell_size), int64_t(0), cells[axis] - 1);
+		}
+		return cell[0] + cells[0] * (cell[1] + cells[1] * cell[2]);
+	};
+
+	// Chunks are numbered in the order their cells are first reached, empty cells don't become chunks
+	HashMap<int64_t, int32_t> cell_chunks;
+	std::vector<SurfaceChunkTriangles> surface_chunks(r_mesh.surfaces.size());
+	auto bucket_triangles = [&](const PackedVector3Array &vertices, const PackedInt32Array &indices, bool create_chunks, std::vector<std::vector<int32_t>> &r_buckets) {
+		for (int64_t triangle = 0; triangle < indices.size() / 3; triangle++) {
+			const int64_t cell = triangle_cell(vertices.ptr(), indices.ptr() + triangle * 3);
+			HashMap<int64_t, int32_t>::Iterator chunk = cell_chunks.find(cell);
+			if (chunk == cell_chunks.end()) {
+				if (!create_chunks) {
+					continue;
+				}
+				chunk = cell_chunks.insert(cell, int32_t(cell_chunks.size()));
+			}
+			if (size_t(chunk->value) >= r_buckets.size()) {
+				r_buckets.resize(chunk->value + 1);
+			}
+			r_buckets[chunk->value].push_back(int32_t(triangle));
+		}
+	};
+	for (int surface_idx = 0; surface_idx < r_mesh.surfaces.size(); surface_idx++) {
+		const MeshSurfaceData &surface = r_mesh.surfaces[surface_idx];
+		bucket_triangles(surface.arrays[Mesh::ARRAY_VERTEX], surface.arrays[Mesh::ARRAY_INDEX], true, surface_chunks[surface_idx].triangles);
+	}
+	for (int surface_idx = 0; surface_idx < r_mesh.surfaces.size(); surface_idx++) {
+		const MeshSurfaceData &surface = r_mesh.surfaces[surface_idx];
+		const Array lod_keys = surface.lods.keys();
+		surface_chunks[surface_idx].lod_triangles.resize(lod_keys.size());
+		for (int lod = 0; lod < lod_keys.size(); lod++) {
+			bucket_triangles(surface.arrays[Mesh::ARRAY_VERTEX], surface.lods[lod_keys[lod]], false, surface_chunks[surface_idx].lod_triangles[lod]);
+		}
+	}
+
+	std::vector<MeshData> chunks(cell_chunks.size());
+	parallel_for(chunks.size(), [&](uint32_t chunk_idx) {
+		MeshData &chunk = chunks[chunk_idx];
+		chunk.name = r_mesh.name + "_chunk" + String::num_int64(chunk_idx);
+
+		for (int surface_idx = 0; surface_idx < r_mesh.surfaces.size(); surface_idx++) {
+			const MeshSurfaceData &surface = r_mesh.surfaces[surface_idx];
+			const SurfaceChunkTriangles &surface_chunk = surface_chunks[surface_idx];
+			if (size_t(chunk_idx) >= surface_chunk.triangles.size() || surface_chunk.triangles[chunk_idx].empty()) {
+				continue;
+			}
+
+			const int64_t vertex_count = PackedVector3Array(surface.arrays[Mesh::ARRAY_VERTEX]).size();
+			HashMap<int32_t, int32_t> chunk_vertices;
+			std::vector<int32_t> sources;
+			auto gather_indices = [&](const PackedInt32Array &indices, const std::vector<int32_t> &triangles) {
+				PackedInt32Array chunk_indices;
+				chunk_indices.resize(int64_t(triangles.size()) * 3);
+				int32_t *chunk_indices_ptr = chunk_indices.ptrw();
+				for (size_t i = 0; i < triangles.size(); i++) {
+					for (int corner = 0; corner < 3; corner++) {
+						const int32_t vertex = indices[int64_t(triangles[i]) * 3 + corner];
+						HashMap<int32_t, int32_t>::Iterator found = chunk_vertices.find(vertex);
+						if (found == chunk_vertices.end()) {
+							found = chunk_vertices.insert(vertex, int32_t(sources.size()));
+							sources.push_back(vertex);
+						}
+						chunk_indices_ptr[i * 3 + corner] = found->value;
+					}
+				}
+				return chunk_indices;
+			};
+
+			MeshSurfaceData chunk_surface;
+			const PackedInt32Array chunk_indices = gather_indices(surface.arrays[Mesh::ARRAY_INDEX], surface_chunk.triangles[chunk_idx]);
+			const Array lod_keys = surface.lods.keys();
+			for (int lod = 0; lod < lod_keys.size(); lod++) {
+				const std::vector<std::vector<int32_t>> &lod_triangles = surface_chunk.lod_triangles[lod];
+				if (size_t(chunk_idx) < lod_triangles.size() && !lod_triangles[chunk_idx].empty()) {
+					chunk_surface.lods[lod_keys[lod]] = gather_indices(surface.lods[lod_keys[lod]], lod_triangles[chunk_idx]);
+				}
+			}
+
+			chunk_surface.arrays = gather_vertex_arrays(surface.arrays, vertex_count, sources);
+			chunk_surface.arrays[Mesh::ARRAY_INDEX] = chunk_indices;
+			chunk_surface.flags = surface.flags;
+			chunk_surface.material = surface.material;
+			chunk_surface.name = surface.name;
+			chunk.surfaces.push_back(chunk_surface);
+		}
+	}, "Split USD mesh into chunks");
+
+	r_mesh.surfaces.clear();
+	r_mesh.chunks = std::move(chunks);
+}
+
+static bool is_skinned_mesh(const Ref<UsdPrimValueGeomMesh> &geom_mesh) {
+	return geom_mesh->has_primvar(UsdPrimValueGeomMesh::PRIMVAR_BONES) && geom_mesh->has_primvar(UsdPrimValueGeomMesh::PRIMVAR_WEIGHTS);
+}
+
+static void negate_vectors(PackedVector3Array &r_vectors) {
+	Vector3 *vectors = r_vectors.ptrw();
+	for (int64_t i = 0; i < r_vectors.size(); i++) {
+		vectors[i] = -vectors[i];
+	}
+}
+
+bool is_subdivision_mesh(const Ref<UsdPrimValueGeomMesh> &geom_mesh) {
+	return geom_mesh->get_subdivision_scheme() != UsdPrimValueGeomMesh::SUBDIVISION_SCHEME_NONE && !is_skinned_mesh(geom_mesh);
+}
+
+int64_t get_subdivision_triangle_count(const Ref<UsdPrimValueGeomMesh> &geom_mesh, const PackedInt32Array &face_vertex_counts, int level) {
+	return get_subdiv_triangle_count(to_subdiv_scheme(geom_mesh->get_subdivision_scheme()), face_vertex_counts, is_subdivision_mesh(geom_mesh) ? level : 0);
+}
+
+bool build_mesh_data(const Ref<UsdPrimValueGeomMesh> &geom_mesh, const Ref<UsdLoadedMaterials> &materials, const Vector3::Axis up_axis, const MeshBuildOptions &options, MeshData *r_mesh) {
+	ERR_FAIL_COND_V_MSG(geom_mesh.is_null(), false, "GeomMesh is null");
+
+	r_mesh->name = geom_mesh->get_name();
+	r_mesh->surfaces.clear();
+
+	// Points are read straight into Godot space. The up axis swizzle mirrors them, so normals that are computed from them
+	// below come out inverted and are negated
+	const bool has_geom_bind_transform = is_skinned_mesh(geom_mesh) && geom_mesh->has_geom_bind_transform();
+	const Transform3D points_transform = get_points_transform(up_axis, options.unit_scale, has_geom_bind_transform ? geom_mesh->get_geom_bind_transform() : Transform3D());
+	const bool mirrored = points_transform.basis.determinant() < 0.0;
+	PackedVector3Array points = geom_mesh->get_transformed_points(points_transform);
+	PackedVector3Array normals = geom_mesh->get_normals();
+	transform_normals(normals, points_transform.basis);
+	UsdGeomPrimvar::Interpolation normal_interp = normals.is_empty() ? UsdGeomPrimvar::INVALID : geom_mesh->get_normals_interpolation();
+	PackedInt32Array face_vertex_counts = geom_mesh->get_face_vertex_counts();
+	PackedInt32Array face_vertex_indices = geom_mesh->get_face_vertex_indices();
+
+	Ref<UsdGeomMeshMaterialMap> material_map = geom_mesh->get_material_map();
+
+	Ref<UsdGeomPrimvar> uv_primvar;
+	bool has_uvs = geom_mesh->has_primvar(UsdPrimValueGeomMesh::PRIMVAR_TEX_UV);
+	if (has_uvs) {
+		uv_primvar = geom_mesh->get_primvar(UsdPrimValueGeomMesh::PRIMVAR_TEX_UV);
+	}
+
+	PackedVector2Array uv_values;
+	UsdGeomPrimvar::Interpolation uv_interp = UsdGeomPrimvar::INVALID;
+	if (has_uvs) {
+		uv_values = uv_primvar->get_vector2_values();
+		uv_interp = uv_primvar->get_interpolation();
+	}
+
+	Ref<UsdGeomPrimvar> bone_primvar;
+	bool has_bones = geom_mesh->has_primvar(UsdPrimValueGeomMesh::PRIMVAR_BONES);
+	if (has_bones) {
+		bone_primvar = geom_mesh->get_primvar(UsdPrimValueGeomMesh::PRIMVAR_BONES);
+	}
+
+	Ref<UsdGeomPrimvar> weight_primvar;
+	bool has_weights = geom_mesh->has_primvar(UsdPrimValueGeomMesh::PRIMVAR_WEIGHTS);
+	if (has_weights) {
+		weight_primvar = geom_mesh->get_primvar(UsdPrimValueGeomMesh::PRIMVAR_WEIGHTS);
+	}
+
+	PackedInt32Array face_material_indices;
+	TypedArray<UsdPath> material_paths;
+	PackedStringArray surface_names;
+	bool has_mapped_materials = material_map->is_mapped();
+
+	if (has_mapped_materials) {
+		face_material_indices = material_map->get_face_material_indices();
+		material_paths = material_map->get_materials();
+		surface_names = material_map->get_surface_names();
+	} else {
+		material_paths = material_map->get_materials();
+	}
+
+	std::vector<SubdivLevel> subdiv_coarse_levels;
+	const UsdPrimValueGeomMesh::SubdivisionScheme subdivision_scheme = geom_mesh->get_subdivision_scheme();
+	if (options.subdivision_level > 0 && subdivision_scheme != UsdPrimValueGeomMesh::SUBDIVISION_SCHEME_NONE) {
+		if (has_bones && has_weights) {
+			WARN_PRINT("Skinned meshes are not subdivided, keeping the cage of " + r_mesh->name);
+		} else {
+			SubdivCage cage;
+			cage.scheme = to_subdiv_scheme(subdivision_scheme);
+			cage.boundary = SubdivBoundary(geom_mesh->get_interpolate_boundary());
+			cage.face_varying_linear = SubdivFaceVaryingLinear(geom_mesh->get_face_varying_linear_interpolation());
+			cage.points = points;
+			cage.face_vertex_counts = face_vertex_counts;
+			cage.face_vertex_indices = face_vertex_indices;
+			cage.crease_indices = geom_mesh->get_crease_indices();
+			cage.crease_lengths = geom_mesh->get_crease_lengths();
+			cage.crease_sharpnesses = geom_mesh->get_crease_sharpnesses();
+			cage.corner_indices = geom_mesh->get_corner_indices();
+			cage.corner_sharpnesses = geom_mesh->get_corner_sharpnesses();
+			cage.hole_indices = geom_mesh->get_hole_indices();
+			if (uv_interp == UsdGeomPrimvar::VERTEX || uv_interp == UsdGeomPrimvar::FACEVARYING) {
+				cage.uvs = uv_values;
+				cage.face_varying_uvs = uv_interp == UsdGeomPrimvar::FACEVARYING;
+			}
+			cage.face_material_indices = face_material_indices;
+
+			SubdivSurface surface;
+			String subdiv_error;
+			if (subdivide_cage(cage, options.subdivision_level, surface, subdiv_error)) {
+				points = surface.points;
+				normals = surface.normals;
+				if (mirrored) {
+					negate_vectors(normals);
+				}
+				normal_interp = UsdGeomPrimvar::VERTEX;
+				face_vertex_counts = surface.face_vertex_counts;
+				face_vertex_indices = surface.face_vertex_indices;
+				face_material_indices = surface.face_material_indices;
+				if (!cage.uvs.is_empty()) {
+					uv_values = surface.uvs;
+				}
+				if (options.subdivision_lods) {
+					subdiv_coarse_levels = std::move(surface.coarse_levels);
+				}
+			} else {
+				WARN_PRINT("Failed to subdivide " + r_mesh->name + ": " + subdiv_error);
+			}
+		}
+	}
+
+	// Every corner reads its normal either per point or per face vertex, anything else is expanded to one of the two
+	switch (normal_interp) {
+		case UsdGeomPrimvar::VERTEX:
+		case UsdGeomPrimvar::VARYING:
+			normal_interp = normals.size() >= points.size() ? UsdGeomPrimvar::VERTEX : UsdGeomPrimvar::INVALID;
+			break;
+		case UsdGeomPrimvar::FACEVARYING:
+			normal_interp = normals.size() >= face_vertex_indices.size() ? UsdGeomPrimvar::FACEVARYING : UsdGeomPrimvar::INVALID;
+			break;
+		case UsdGeomPrimvar::UNIFORM: {
+			if (normals.size() < face_vertex_counts.size()) {
+				normal_interp = UsdGeomPrimvar::INVALID;
+				break;
+			}
+			PackedVector3Array face_vertex_normals;
+			face_vertex_normals.resize(face_vertex_indices.size());
+			Vector3 *face_vertex_normals_ptr = face_vertex_normals.ptrw();
+			int64_t corner = 0;
+			for (int64_t face = 0; face < face_vertex_counts.size(); face++) {
+				const int32_t count = MIN(face_vertex_counts[face], int32_t(face_vertex_normals.size() - corner));
+				std::fill_n(face_vertex_normals_ptr + corner, MAX(count, 0), normals[face]);
+				corner += MAX(count, 0);
+			}
+			normals = face_vertex_normals;
+			normal_interp = UsdGeomPrimvar::FACEVARYING;
+			break;
+		}
+		case UsdGeomPrimvar::CONSTANT: {
+			const Vector3 normal = normals[0];
+			normals.resize(points.size());
+			normals.fill(normal);
+			normal_interp = UsdGeomPrimvar::VERTEX;
+			break;
+		}
+		default:
+			normal_interp = UsdGeomPrimvar::INVALID;
+			break;
+	}
+
+	if (normal_interp == UsdGeomPrimvar::INVALID) {
+		if (!normals.is_empty()) {
+			WARN_PRINT("Normals of " + r_mesh->name + " don't match its topology, generating them instead");
+		}
+		String normals_error;
+		if (generate_normals(points, face_vertex_counts, face_vertex_indices, Math::deg_to_rad(options.normal_crease_angle), normals, normals_error)) {
+			normal_interp = UsdGeomPrimvar::FACEVARYING;
+			if (mirrored) {
+				negate_vectors(normals);
+			}
+		} else {
+			WARN_PRINT("Failed to generate normals of " + r_mesh->name + ": " + normals_error);
+			normals.clear();
+		}
+	}
+
+	// Skin influences are per point, so they are resolved once for the whole mesh and copied per surface
+	PointSkin point_skin;
+	bool has_skin = false;
+	if (has_bones && has_weights) {
+		const UsdGeomPrimvar::Interpolation bone_interp = bone_primvar->get_interpolation();
+		const bool constant = bone_interp == UsdGeomPrimvar::CONSTANT;
+		String skin_error;
+
+		if (bone_interp != weight_primvar->get_interpolation() || (!constant && bone_interp != UsdGeomPrimvar::VERTEX)) {
+			WARN_PRINT("Skin primvars must both have VERTEX or CONSTANT interpolation, ignoring skin of " + r_mesh->name);
+		} else if (!build_point_skin(bone_primvar->get_int_values(), weight_primvar->get_float_values(), bone_primvar->get_element_size(), constant, points.size(), point_skin, skin_error)) {
+			WARN_PRINT("Failed to read skin of " + r_mesh->name + ": " + skin_error);
+		} else {
+			has_skin = true;
+		}
+	}
+
+	PackedInt32Array triangulated_face_vertex_counts;
+	PackedInt32Array triangulated_face_vertex_indices;
+	PackedInt64Array triangulated_to_orig_face_vertex_index_map;
+	PackedInt32Array triangulated_face_counts;
+	String error;
+
+	bool success = triangulate_polygon(
+			points,
+			face_vertex_counts,
+			face_vertex_indices,
+			triangulated_face_vertex_counts,
+			triangulated_face_vertex_indices,
+			triangulated_to_orig_face_vertex_index_map,
+			triangulated_face_counts,
+			error);
+
+	ERR_FAIL_COND_V_MSG(!success, false, "Failed to triangulate mesh: " + error);
+
+	// Finest of the coarse levels first, so the LOD edge lengths grow with the index
+	std::vector<SubdivLod> subdiv_lods(subdiv_coarse_levels.size());
+	for (size_t lod_idx = 0; lod_idx < subdiv_lods.size(); lod_idx++) {
+		const SubdivLevel &level = subdiv_coarse_levels[subdiv_coarse_levels.size() - 1 - lod_idx];
+		SubdivLod &lod = subdiv_lods[lod_idx];
+		PackedInt32Array lod_triangle_counts;
+		PackedInt64Array lod_to_orig_face_vertex_index_map;
+		String lod_error;
+		if (!triangulate_polygon(points, level.face_vertex_counts, level.face_vertex_indices, lod_triangle_counts, lod.triangle_points, lod_to_orig_face_vertex_index_map, lod.triangle_face_counts, lod_error)) {
+			WARN_PRINT("Failed to triangulate subdivision LOD of " + r_mesh->name + ": " + lod_error);
+			subdiv_lods.clear();
+			break;
+		}
+		lod.face_material_indices = level.face_material_indices;
+		lod.edge_length = get_mean_edge_length(points, level.face_vertex_counts, level.face_vertex_indices);
+	}
+
+	// Counting sort of the triangles by material. Surface i holds material i, faces without material go into one extra
+	// surface after them. The triangles of surface i are sorted_triangles[surface_offsets[i], surface_offsets[i + 1])
+	const int material_count = has_mapped_materials ? material_paths.size() : 1;
+	const int surface_count = material_count + 1;
+	const int unassigned_surface = material_count;
+	const int32_t *face_tri_counts_ptr = triangulated_face_counts.ptr();
+	const int64_t face_count = triangulated_face_counts.size();
+
+	auto material_surface = [&](const PackedInt32Array &material_indices, int64_t face) {
+		if (!has_mapped_materials) {
+			return 0;
+		}
+		const int32_t material_idx = face < material_indices.size() ? material_indices.ptr()[face] : -1;
+		return material_idx >= 0 && material_idx < material_count ? int(material_idx) : unassigned_surface;
+	};
+	auto face_surface = [&](int64_t face) {
+		return material_surface(face_material_indices, face);
+	};
+
+	std::vector<int32_t> surface_offsets(surface_count + 1, 0);
+	for (int64_t face = 0; face < face_count; face++) {
+		surface_offsets[face_surface(face) + 1] += face_tri_counts_ptr[face];
+	}
+	for (int surface = 0; surface < surface_count; surface++) {
+		surface_offsets[surface + 1] += surface_offsets[surface];
+	}
+
+	std::vector<int32_t> sorted_triangles(surface_offsets[surface_count]);
+	std::vector<int32_t> write_offsets(surface_offsets.begin(), surface_offsets.end() - 1);
+	int32_t tri_face_index = 0;
+	for (int64_t face = 0; face < face_count; face++) {
+		int32_t &write_offset = write_offsets[face_surface(face)];
+		for (int32_t j = 0; j < face_tri_counts_ptr[face]; j++) {
+			sorted_triangles[write_offset++] = tri_face_index++;
+		}
+	}
+
+	for (int material_idx = 0; material_idx < surface_count; material_idx++) {
+		const int32_t *triangle_indices = sorted_triangles.data() + surface_offsets[material_idx];
+		const int32_t triangle_count = surface_offsets[material_idx + 1] - surface_offsets[material_idx];
+		if (triangle_count == 0) {
+			continue;
+		}
+
+		Array surface_arrays;
+		surface_arrays.resize(Mesh::ARRAY_MAX);
+
+		PackedVector3Array surface_vertices;
+		PackedVector3Array surface_normals;
+		PackedVector2Array surface_uvs;
+		PackedInt32Array surface_indices;
+
+		PackedFloat32Array surface_weights;
+		PackedInt32Array surface_bones;
+
+		const Vector2 *uv_ptr = uv_values.ptr();
+		const Vector3 *normals_ptr = normals.ptr();
+		const bool has_normals = normal_interp != UsdGeomPrimvar::INVALID;
+		const bool has_surface_uvs = uv_interp == UsdGeomPrimvar::VERTEX || uv_interp == UsdGeomPrimvar::FACEVARYING;
+
+		// Corners sharing point, uv and normal become one vertex, skin weights are per point so they are covered by it
+		HashMap<VertexKey, int32_t, VertexKeyHasher> welded_vertices;
+		Vector<int32_t> vertex_points;
+		surface_indices.resize(triangle_count * 3);
+
+		for (int i = 0; i < triangle_count; i++) {
+			int base_idx = triangle_indices[i] * 3;
+
+			for (int j = 0; j < 3; j++) {
+				VertexKey key;
+				key.point = triangulated_face_vertex_indices[base_idx + j];
+
+				if (normal_interp == UsdGeomPrimvar::FACEVARYING) {
+					key.normal = normals_ptr[triangulated_to_orig_face_vertex_index_map[base_idx + j]];
+				} else if (has_normals) {
+					key.normal = normals_ptr[key.point];
+				}
+
+				if (has_surface_uvs) {
+					int64_t uv_idx = uv_interp == UsdGeomPrimvar::VERTEX ? key.point : triangulated_to_orig_face_vertex_index_map[base_idx + j];
+					if (uv_idx < uv_values.size()) {
+						key.uv = uv_ptr[uv_idx];
+						key.uv.y = 1.0 - key.uv.y;
+					}
+				}
+
+				HashMap<VertexKey, int32_t, VertexKeyHasher>::Iterator found = welded_vertices.find(key);
+				int32_t vertex_idx;
+				if (found != welded_vertices.end()) {
+					vertex_idx = found->value;
+				} else {
+					vertex_idx = surface_vertices.size();
+					welded_vertices.insert(key, vertex_idx);
+					vertex_points.push_back(key.point);
+					surface_vertices.push_back(points[key.point]);
+					if (has_normals) {
+						surface_normals.push_back(key.normal);
+					}
+					if (has_surface_uvs) {
+						surface_uvs.push_back(key.uv);
+					}
+				}
+
+				surface_indices.set(i * 3 + j, vertex_idx);
+			}
+		}
+
+		if (has_skin) {
+			const int influence_count = point_skin.influence_count;
+			surface_bones.resize(vertex_points.size() * influence_count);
+			surface_weights.resize(vertex_points.size() * influence_count);
+			int32_t *bones_ptr = surface_bones.ptrw();
+			float *weights_ptr = surface_weights.ptrw();
+
+			for (int vertex_idx = 0; vertex_idx < vertex_points.size(); vertex_idx++) {
+				const size_t src = size_t(vertex_points[vertex_idx]) * influence_count;
+				std::copy_n(point_skin.bones.data() + src, influence_count, bones_ptr + size_t(vertex_idx) * influence_count);
+				std::copy_n(point_skin.weights.data() + src, influence_count, weights_ptr + size_t(vertex_idx) * influence_count);
+			}
+		}
+
+		Ref<StandardMaterial3D> surface_material;
+		if (materials.is_valid() && material_idx < material_paths.size()) {
+			Ref<UsdPath> material_path = material_paths[material_idx];
+			if (material_path.is_valid()) {
+				surface_material = materials->get_material_with_path(material_path);
+			}
+		}
+
+		// Only normal maps need tangents, Godot would otherwise generate them on the main thread when saving the mesh
+		PackedFloat32Array surface_tangents;
+		const bool has_normal_map = surface_material.is_valid() && surface_material->get_texture(BaseMaterial3D::TEXTURE_NORMAL).is_valid();
+		if (has_normal_map && !surface_normals.is_empty() && !surface_uvs.is_empty()) {
+			generate_tangents(surface_vertices, surface_normals, surface_uvs, surface_indices, surface_tangents);
+		}
+
+		int64_t surface_flags = Mesh::ARRAY_FORMAT_VERTEX | Mesh::ARRAY_FORMAT_INDEX;
+		surface_arrays[Mesh::ARRAY_VERTEX] = surface_vertices;
+		surface_arrays[Mesh::ARRAY_INDEX] = surface_indices;
+
+		if (!surface_normals.is_empty()) {
+			surface_flags |= Mesh::ARRAY_FORMAT_NORMAL;
+			surface_arrays[Mesh::ARRAY_NORMAL] = surface_normals;
+		}
+
+		if (!surface_uvs.is_empty()) {
+			surface_flags |= Mesh::ARRAY_FORMAT_TEX_UV;
+			surface_arrays[Mesh::ARRAY_TEX_UV] = surface_uvs;
+		}
+
+		if (!surface_tangents.is_empty()) {
+			surface_flags |= Mesh::ARRAY_FORMAT_TANGENT;
+			surface_arrays[Mesh::ARRAY_TANGENT] = surface_tangents;
+		}
+
+		if (has_skin) {
+			surface_arrays[Mesh::ARRAY_BONES] = surface_bones;
+			surface_arrays[Mesh::ARRAY_WEIGHTS] = surface_weights;
+
+			surface_flags |= Mesh::ARRAY_FORMAT_WEIGHTS;
+			surface_flags |= Mesh::ARRAY_FORMAT_BONES;
+			if (point_skin.influence_count == 8) {
+				surface_flags |= Mesh::ARRAY_FLAG_USE_8_BONE_WEIGHTS;
+			}
+		}
+
+		// A coarse level's point continues as the refined point with the same index, which lies on the limit surface.
+		// Seams take the first welded vertex of a point, coarse LODs are only drawn at a distance
+		Dictionary surface_lods;
+		if (!subdiv_lods.empty()) {
+			std::vector<int32_t> point_vertices(points.size(), -1);
+			for (int vertex_idx = vertex_points.size() - 1; vertex_idx >= 0; vertex_idx--) {
+				point_vertices[vertex_points[vertex_idx]] = vertex_idx;
+			}
+
+			for (const SubdivLod &lod : subdiv_lods) {
+				PackedInt32Array lod_indices;
+				const int32_t *lod_points = lod.triangle_points.ptr();
+				int64_t triangle = 0;
+				for (int64_t face = 0; face < lod.triangle_face_counts.size(); face++) {
+					const int32_t face_triangles = lod.triangle_face_counts[face];
+					if (material_surface(lod.face_material_indices, face) == material_idx) {
+						for (int32_t i = 0; i < face_triangles; i++) {
+							const int64_t base_idx = (triangle + i) * 3;
+							const int32_t a = point_vertices[lod_points[base_idx]];
+							const int32_t b = point_vertices[lod_points[base_idx + 1]];
+							const int32_t c = point_vertices[lod_points[base_idx + 2]];
+							if (a >= 0 && b >= 0 && c >= 0) {
+								lod_indices.push_back(a);
+								lod_indices.push_back(b);
+								lod_indices.push_back(c);
+							}
+						}
+					}
+					triangle += face_triangles;
+				}
+
+				if (!lod_indices.is_empty() && lod_indices.size() < surface_indices.size()) {
+					surface_lods[lod.edge_length] = lod_indices;
+				}
+			}
+		}
+
+		MeshSurfaceData surface;
+		surface.arrays = surface_arrays;
+		surface.flags = surface_flags;
+		surface.lods = surface_lods;
+		surface.name = material_idx < surface_names.size() ? surface_names[material_idx] : String();
+		surface.material = surface_material;
+		r_mesh->surfaces.push_back(surface);
+	}
+
+	if (!has_skin && (options.chunk_triangle_count > 0 || options.chunk_extent > 0.0)) {
+		split_mesh_chunks(*r_mesh, options);
+	}
+
+	std::vector<MeshSurfaceData *> surfaces;
+	for (MeshSurfaceData &surface : r_mesh->surfaces) {
+		surfaces.push_back(&surface);
+	}
+	for (MeshData &chunk : r_mesh->chunks) {
+		for (MeshSurfaceData &surface : chunk.surfaces) {
+			surfaces.push_back(&surface);
+		}
+	}
+
+	// Surfaces that didn't get LODs from subdivision are simplified, each on its own worker
+	if (options.generate_lods) {
+		parallel_for(surfaces.size(), [&](uint32_t surface_idx) {
+			MeshSurfaceData &surface = *surfaces[surface_idx];
+			if (!surface.lods.is_empty()) {
+				return;
+			}
+
+			std::vector<SimplifiedLod> lods;
+			generate_lod_chain(surface.arrays[Mesh::ARRAY_VERTEX], surface.arrays[Mesh::ARRAY_NORMAL], surface.arrays[Mesh::ARRAY_TEX_UV], surface.arrays[Mesh::ARRAY_INDEX], lods);
+			for (const SimplifiedLod &lod : lods) {
+				surface.lods[lod.error] = lod.indices;
+			}
+		}, "Simplify USD mesh surfaces");
+	}
+
+	if (options.optimize_vertex_order) {
+		parallel_for(surfaces.size(), [&](uint32_t surface_idx) {
+			optimize_surface(*surfaces[surface_idx]);
+		}, "Optimize USD mesh surfaces");
+	}
+
+	return true;
+}
+
+Ref<ImporterMesh> create_importer_mesh(const MeshData &mesh_data) {
+	Ref<ImporterMesh> mesh;
+	mesh.instantiate();
+	mesh->set_name(mesh_data.name);
+
+	for (const MeshSurfaceData &surface : mesh_data.surfaces) {
+		mesh->add_surface(Mesh::PRIMITIVE_TRIANGLES, surface.arrays, {}, surface.lods, surface.material, surface.name, surface.flags);
+	}
+
+	return mesh;
+}
+
+Vector<Ref<ImporterMesh>> create_importer_meshes(const MeshData &mesh_data) {
+	Vector<Ref<ImporterMesh>> meshes;
+	if (mesh_data.chunks.empty()) {
+		meshes.push_back(create_importer_mesh(mesh_data));
+	}
+	for (const MeshData &chunk : mesh_data.chunks) {
+		meshes.push_back(create_importer_mesh(chunk));
+	}
+	return meshes;
+}
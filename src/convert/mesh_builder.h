@@ -0,0 +1,64 @@
+#pragma once
+
+#include <godot_cpp/classes/importer_mesh.hpp>
+#include <godot_cpp/classes/standard_material3d.hpp>
+#include <godot_cpp/templates/vector.hpp>
+#include <godot_cpp/variant/array.hpp>
+#include <godot_cpp/variant/dictionary.hpp>
+
+#include <vector>
+
+#include "usd/usd_geom.h"
+#include "usd/usd_shade.h"
+
+/// Surface arrays ready for ImporterMesh::add_surface
+struct MeshSurfaceData {
+	godot::Array arrays;
+	int64_t flags = 0;
+	godot::Ref<godot::StandardMaterial3D> material;
+	godot::String name;
+	/// Mesh LOD edge length to the index array drawn from it, on the vertices of arrays
+	godot::Dictionary lods;
+};
+
+/// Import settings that change the generated geometry
+struct MeshBuildOptions {
+	/// Uniform subdivision level for meshes with a subdivisionScheme, 0 keeps the cage
+	int subdivision_level = 0;
+	/// Keep the coarser subdivision levels as LODs of the refined surfaces
+	bool subdivision_lods = true;
+	/// Simplify surfaces into a LOD chain, unless subdivision already gave them LODs
+	bool generate_lods = true;
+	/// Reorder triangles for the vertex cache and overdraw, and vertices for fetch locality
+	bool optimize_vertex_order = true;
+	/// Unskinned meshes with more triangles are split into grid chunks of about this many triangles each, 0 disables this
+	int64_t chunk_triangle_count = 0;
+	/// Unskinned meshes larger than this along any axis are split into grid chunks at most this large, 0 disables this
+	float chunk_extent = 0.0;
+	/// Points are scaled by this while they are read, the stage's metersPerUnit to import in meters
+	real_t unit_scale = 1.0;
+	/// Generated normals are only smoothed across edges whose faces are at most this many degrees apart
+	float normal_crease_angle = 60.0;
+};
+
+struct MeshData {
+	godot::String name;
+	godot::Vector<MeshSurfaceData> surfaces;
+	/// Set instead of surfaces if the mesh was split into spatial chunks, each with the surfaces of its part of the mesh
+	std::vector<MeshData> chunks;
+};
+
+/// Triangulates the mesh and builds the arrays of all its surfaces.
+/// Only reads the stage and materials, so it can run on worker threads for different meshes at once
+bool build_mesh_data(const godot::Ref<UsdPrimValueGeomMesh> &geom_mesh, const godot::Ref<UsdLoadedMaterials> &materials, const godot::Vector3::Axis up_axis, const MeshBuildOptions &options, MeshData *r_mesh);
+
+/// Whether build_mesh_data refines the mesh for a subdivision level above 0, skinned meshes keep their cage
+bool is_subdivision_mesh(const godot::Ref<UsdPrimValueGeomMesh> &geom_mesh);
+
+/// Triangles build_mesh_data emits for the mesh at a subdivision level, counted on the cage without refining it
+int64_t get_subdivision_triangle_count(const godot::Ref<UsdPrimValueGeomMesh> &geom_mesh, const godot::PackedInt32Array &face_vertex_counts, int level);
+
+/// ImporterMesh isn't safe to fill from multiple threads, so this is the serial part of the conversion
+godot::Ref<godot::ImporterMesh> create_importer_mesh(const MeshData &mesh_data);
+/// One mesh per chunk, or the single mesh if it wasn't split
+godot::Vector<godot::Ref<godot::ImporterMesh>> create_importer_meshes(const MeshData &mesh_data);
@@ -13,7 +13,10 @@ void UsdSceneFormatImporter::_bind_methods() {
 
 PackedStringArray UsdSceneFormatImporter::_get_extensions() const {
 	PackedStringArray extensions;
+	extensions.push_back("usd");
 	extensions.push_back("usda");
+	extensions.push_back("usdc");
+	extensions.push_back("usdz");
 	return extensions;
 }
 
@@ -26,8 +29,33 @@ Object *UsdSceneFormatImporter::_import_scene(const String &p_path, uint32_t p_f
 		return nullptr;
 	}
 
+	if (bool(p_options.get("usd/load_payloads", true)) && !stage->load_all_payloads()) {
+		UtilityFunctions::push_warning("Failed to load payloads of USD stage: ", p_path);
+	}
+
 	Ref<UsdGodotSceneConverter> converter;
 	converter.instantiate();
+	converter->set_build_meshes_in_parallel(true);
+	converter->set_share_duplicate_meshes(p_options.get("usd/share_duplicate_meshes", true));
+	converter->set_multimesh_instance_threshold(p_options.get("usd/multimesh_instance_threshold", 64));
+	converter->set_subdivision_level(p_options.get("usd/subdivision_level", 0));
+	converter->set_subdivision_triangle_budget(p_options.get("usd/subdivision_triangle_budget", 0));
+	bool subdivision_lods = p_options.get("usd/subdivision_lods", true);
+	bool generate_lods = p_options.get("usd/generate_lods", true);
+	// Godot's own LOD generation replaces the LODs of every mesh after import, so ours would only cost import time
+	if (bool(p_options.get("meshes/generate_lods", true)) && (subdivision_lods || generate_lods)) {
+		UtilityFunctions::push_warning("USD LODs are replaced by meshes/generate_lods, disable it to keep usd/generate_lods and usd/subdivision_lods: ", p_path);
+		subdivision_lods = false;
+		generate_lods = false;
+	}
+	converter->set_subdivision_lods(subdivision_lods);
+	converter->set_generate_lods(generate_lods);
+	converter->set_optimize_vertex_order(p_options.get("usd/optimize_vertex_order", true));
+	converter->set_chunk_triangle_count(p_options.get("usd/chunk_triangle_count", 0));
+	converter->set_chunk_extent(p_options.get("usd/chunk_extent", 0.0));
+	converter->set_normal_crease_angle(p_options.get("usd/normal_crease_angle", 60.0));
+	const real_t unit_scale = bool(p_options.get("usd/apply_meters_per_unit", false)) ? real_t(stage->get_meters_per_unit()) : real_t(1.0);
+	converter->set_unit_scale(unit_scale);
 
 	if (!converter->load(stage)) {
 		UtilityFunctions::push_error("Failed to initialize scene converter with stage");
@@ -49,6 +77,7 @@ Object *UsdSceneFormatImporter::_import_scene(const String &p_path, uint32_t p_f
 	if (root_prims.size() == 1 && root_prims[0]->get_type() == UsdPrimType::USD_PRIM_TYPE_XFORM) {
 		Ref<UsdPrimValueXform> value = root_prims[0]->get_value();
 		Transform3D xform = apply_up_axis(value->get_transform(), up_axis);
+		xform.origin *= unit_scale;
 		root_node->set_transform(xform);
 		root_node->set_name(value->get_name());
 
@@ -58,11 +87,24 @@ Object *UsdSceneFormatImporter::_import_scene(const String &p_path, uint32_t p_f
 	for (int i = 0; i < root_prims.size(); i++) {
 		converter->convert_prim(root_prims[i], root_node, up_axis);
 	}
+	converter->build_pending_meshes();
 
 	return root_node;
 }
 
 void UsdSceneFormatImporter::_get_import_options(const String &p_path) {
+	add_import_option("usd/load_payloads", true);
+	add_import_option("usd/share_duplicate_meshes", true);
+	add_import_option("usd/multimesh_instance_threshold", 64);
+	add_import_option("usd/subdivision_level", 0);
+	add_import_option("usd/subdivision_triangle_budget", 0);
+	add_import_option("usd/subdivision_lods", true);
+	add_import_option("usd/generate_lods", true);
+	add_import_option("usd/optimize_vertex_order", true);
+	add_import_option("usd/chunk_triangle_count", 0);
+	add_import_option("usd/chunk_extent", 0.0);
+	add_import_option("usd/normal_crease_angle", 60.0);
+	add_import_option("usd/apply_meters_per_unit", false);
 }
 
 Variant UsdSceneFormatImporter::_get_option_visibility(const String &p_path, bool p_for_animation, const String &p_option) const {
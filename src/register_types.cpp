@@ -17,6 +17,7 @@
 #include "usd/usd_prim_value.h"
 #include "usd/usd_skel.h"
 #include "usd/usd_stage.h"
+#include "usd/usd_stage_cache.h"
 
 namespace godot {
 void gdextension_initialize(ModuleInitializationLevel p_level) {
@@ -28,6 +29,7 @@ void gdextension_initialize(ModuleInitializationLevel p_level) {
 		ClassDB::register_class<UsdPrimValue>();
 		ClassDB::register_class<UsdPrimValueXform>();
 		ClassDB::register_class<UsdPrimValueGeomMesh>();
+		ClassDB::register_class<UsdPrimValuePointInstancer>();
 		ClassDB::register_class<UsdGeomPrimvar>();
 		ClassDB::register_class<UsdPrimValueGeomMaterialSubset>();
 		ClassDB::register_class<UsdLoadedMaterials>();
@@ -46,6 +48,7 @@ void gdextension_initialize(ModuleInitializationLevel p_level) {
 
 void gdextension_terminate(ModuleInitializationLevel p_level) {
 	if (p_level == MODULE_INITIALIZATION_LEVEL_SCENE) {
+		UsdStageCache::get_singleton()->clear();
 	}
 	if (p_level == MODULE_INITIALIZATION_LEVEL_EDITOR) {
 		EditorPlugins::remove_by_type<UsdEditorPlugin>();
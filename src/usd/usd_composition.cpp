@@ -0,0 +1,172 @@
+#include "usd_composition.h"
+
+#include "asset-resolution.hh"
+#include "composition.hh"
+#include "tinyusdz.hh"
+
+// Referenced layers can reference further layers, this only guards against reference cycles
+static constexpr int MAX_COMPOSITION_ITERATIONS = 32;
+
+static bool prim_spec_has_composition_arcs(const tinyusdz::PrimSpec &spec) {
+	const tinyusdz::PrimMeta &metas = spec.metas();
+	if (metas.references || metas.payload || metas.inherits || metas.specializes || metas.variantSets) {
+		return true;
+	}
+
+	for (const tinyusdz::PrimSpec &child : spec.children()) {
+		if (prim_spec_has_composition_arcs(child)) {
+			return true;
+		}
+	}
+	return false;
+}
+
+bool layer_has_composition_arcs(const tinyusdz::Layer &layer) {
+	if (!layer.metas().subLayers.empty()) {
+		return true;
+	}
+
+	for (const auto &it : layer.primspecs()) {
+		if (prim_spec_has_composition_arcs(it.second)) {
+			return true;
+		}
+	}
+	return false;
+}
+
+// Payloads of prims that aren't loaded are removed before composing, so tinyusdz never opens their layers
+static void strip_unloaded_payloads(tinyusdz::PrimSpec &spec, const std::string &parent_path, const std::set<std::string> &loaded_payloads, std::set<std::string> *r_payload_paths) {
+	const std::string path = parent_path + "/" + spec.name();
+
+	if (spec.metas().payload) {
+		r_payload_paths->insert(path);
+		if (loaded_payloads.find(path) == loaded_payloads.end()) {
+			spec.metas().payload.reset();
+		}
+	}
+
+	for (tinyusdz::PrimSpec &child : spec.children()) {
+		strip_unloaded_payloads(child, path, loaded_payloads, r_payload_paths);
+	}
+}
+
+static void add_asset_path(const tinyusdz::AssetResolutionResolver &resolver, const std::string &asset_path, std::set<std::string> *r_asset_paths) {
+	const std::string resolved = resolver.resolve(asset_path);
+	if (!resolved.empty()) {
+		r_asset_paths->insert(resolved);
+	}
+}
+
+// Files the next composition iteration opens, payloads of unloaded prims were already stripped
+static void collect_asset_paths(const tinyusdz::AssetResolutionResolver &resolver, const tinyusdz::PrimSpec &spec, std::set<std::string> *r_asset_paths) {
+	const tinyusdz::PrimMeta &metas = spec.metas();
+	if (metas.references) {
+		for (const tinyusdz::Reference &reference : metas.references.value().second) {
+			add_asset_path(resolver, reference.asset_path.GetAssetPath(), r_asset_paths);
+		}
+	}
+	if (metas.payload) {
+		for (const tinyusdz::Payload &payload : metas.payload.value().second) {
+			add_asset_path(resolver, payload.asset_path.GetAssetPath(), r_asset_paths);
+		}
+	}
+
+	for (const tinyusdz::PrimSpec &child : spec.children()) {
+		collect_asset_paths(resolver, child, r_asset_paths);
+	}
+}
+
+bool compose_stage(const tinyusdz::Layer &root_layer,
+		const std::string &base_dir,
+		const UsdzArchive *archive,
+		const std::set<std::string> &loaded_payloads,
+		tinyusdz::Stage *r_stage,
+		std::set<std::string> *r_payload_paths,
+		std::string *r_err,
+		std::set<std::string> *r_asset_paths) {
+	tinyusdz::AssetResolutionResolver resolver;
+	resolver.set_current_working_path(base_dir);
+	resolver.set_search_paths({ base_dir });
+
+	tinyusdz::USDZAsset usdz_asset;
+	if (archive) {
+		archive->fill_usdz_asset(&usdz_asset);
+		tinyusdz::SetupUSDZAssetResolution(resolver, &usdz_asset);
+	}
+
+	std::string warn;
+	tinyusdz::Layer layer = root_layer;
+
+	// Files inside the archive change with it, only loose files are tracked
+	const bool track_assets = r_asset_paths && !archive;
+
+	if (track_assets) {
+		for (const tinyusdz::SubLayer &sublayer : layer.metas().subLayers) {
+			add_asset_path(resolver, sublayer.assetPath.GetAssetPath(), r_asset_paths);
+		}
+	}
+
+	if (layer.check_unresolved_sublayers()) {
+		tinyusdz::Layer composited;
+		if (!tinyusdz::CompositeSublayers(resolver, layer, &composited, &warn, r_err)) {
+			return false;
+		}
+		layer = std::move(composited);
+	}
+
+	for (int i = 0; i < MAX_COMPOSITION_ITERATIONS; i++) {
+		// Referenced layers bring their own payloads, so this has to run every iteration
+		for (auto &it : layer.primspecs()) {
+			strip_unloaded_payloads(it.second, "", loaded_payloads, r_payload_paths);
+		}
+		if (track_assets) {
+			for (const auto &it : layer.primspecs()) {
+				collect_asset_paths(resolver, it.second, r_asset_paths);
+			}
+		}
+
+		bool composed = false;
+
+		if (layer.check_unresolved_references()) {
+			tinyusdz::Layer composited;
+			if (!tinyusdz::CompositeReferences(resolver, layer, &composited, &warn, r_err)) {
+				return false;
+			}
+			layer = std::move(composited);
+			composed = true;
+		}
+
+		if (layer.check_unresolved_payload()) {
+			tinyusdz::Layer composited;
+			if (!tinyusdz::CompositePayload(resolver, layer, &composited, &warn, r_err)) {
+				return false;
+			}
+			layer = std::move(composited);
+			composed = true;
+		}
+
+		if (layer.check_unresolved_inherits()) {
+			tinyusdz::Layer composited;
+			if (!tinyusdz::CompositeInherits(layer, &composited, &warn, r_err)) {
+				return false;
+			}
+			layer = std::move(composited);
+			composed = true;
+		}
+
+		if (layer.check_unresolved_variant()) {
+			tinyusdz::Layer composited;
+			if (!tinyusdz::CompositeVariant(layer, &composited, &warn, r_err)) {
+				return false;
+			}
+			layer = std::move(composited);
+			composed = true;
+		}
+
+		if (!composed) {
+			break;
+		}
+	}
+
+	return tinyusdz::LayerToStage(layer, r_stage, &warn, r_err);
+}
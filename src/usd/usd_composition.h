@@ -0,0 +1,24 @@
+#pragma once
+
+#include <set>
+#include <string>
+
+#include "prim-types.hh"
+#include "stage.hh"
+#include "utils/usdz_archive.h"
+
+/// Returns true if the layer has sublayers or prims with references, payloads, inherits, specializes or variant sets.
+/// Those are ignored when converting the layer to a stage directly and need it to be composed instead
+bool layer_has_composition_arcs(const tinyusdz::Layer &layer);
+
+/// Composes root_layer into r_stage. Assets are resolved relative to base_dir, or inside archive for usdz packages.
+/// Payloads are only composed for prims in loaded_payloads, all prims that have a payload are added to r_payload_paths.
+/// If set, r_asset_paths gets the resolved files of all sublayers, references and loaded payloads outside of archive
+bool compose_stage(const tinyusdz::Layer &root_layer,
+		const std::string &base_dir,
+		const UsdzArchive *archive,
+		const std::set<std::string> &loaded_payloads,
+		tinyusdz::Stage *r_stage,
+		std::set<std::string> *r_payload_paths,
+		std::string *r_err,
+		std::set<std::string> *r_asset_paths = nullptr);
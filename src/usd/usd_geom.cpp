@@ -13,12 +13,37 @@
 #include "tydra/shader-network.hh"
 #include "usd/usd_prim_value.h"
 #include "usdGeom.hh"
+#include "utils/geom_utils.h"
 #include "utils/godot_utils.h"
+#include "utils/hash_utils.h"
 #include "utils/type_utils.h"
 #include "value-types.hh"
 
 using namespace godot;
 
+// Default time value of an attribute that may also have time samples
+template <typename T>
+static bool get_default_value(const tinyusdz::TypedAttribute<tinyusdz::Animatable<T>> &attr, T *r_value) {
+	if (!attr.has_value()) {
+		return false;
+	}
+
+	tinyusdz::Animatable<T> animatable;
+	if (!attr.get_value(&animatable)) {
+		return false;
+	}
+	return animatable.get(tinyusdz::value::TimeCode::Default(), r_value);
+}
+
+template <typename T>
+static T get_default_value(const tinyusdz::TypedAttributeWithFallback<tinyusdz::Animatable<T>> &attr, const T &fallback) {
+	T value;
+	if (attr.get_value().get(tinyusdz::value::TimeCode::Default(), &value)) {
+		return value;
+	}
+	return fallback;
+}
+
 UsdGeomPrimvar::Interpolation UsdGeomPrimvar::interpolation_from_internal(tinyusdz::Interpolation interpolation) {
 	switch (interpolation) {
 		case tinyusdz::Interpolation::Constant:
@@ -69,6 +94,28 @@ void UsdGeomPrimvar::set_values(const Array &values) {
 	_values = values;
 }
 
+PackedVector2Array UsdGeomPrimvar::get_vector2_values() const {
+	return _values;
+}
+
+PackedFloat32Array UsdGeomPrimvar::get_float_values() const {
+	return _values;
+}
+
+PackedInt32Array UsdGeomPrimvar::get_int_values() const {
+	return _values;
+}
+
+PackedColorArray UsdGeomPrimvar::get_color_values() const {
+	return _values;
+}
+
+void UsdGeomPrimvar::set_packed_values(const Variant &values) {
+	ERR_FAIL_COND(values.get_type() != Variant::PACKED_VECTOR2_ARRAY && values.get_type() != Variant::PACKED_FLOAT32_ARRAY &&
+			values.get_type() != Variant::PACKED_INT32_ARRAY && values.get_type() != Variant::PACKED_COLOR_ARRAY);
+	_values = values;
+}
+
 UsdGeomPrimvar::Interpolation UsdGeomPrimvar::get_interpolation() const {
 	return _interpolation;
 }
@@ -102,7 +149,7 @@ String UsdGeomPrimvar::_to_string() const {
 	info += "name: " + _name + ", ";
 	info += "interpolation: " + String::num_int64(_interpolation) + ", ";
 	info += "element_size: " + String::num_int64(_element_size) + ", ";
-	info += "values: " + String::num_int64(_values.size()) + ", ";
+	info += "values: " + String::num_int64(get_values().size()) + ", ";
 	info += "indices: " + String::num_int64(_indices.size());
 	return info;
 }
@@ -112,6 +159,10 @@ void UsdGeomPrimvar::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("set_name", "name"), &UsdGeomPrimvar::set_name);
 	ClassDB::bind_method(D_METHOD("get_values"), &UsdGeomPrimvar::get_values);
 	ClassDB::bind_method(D_METHOD("set_values", "values"), &UsdGeomPrimvar::set_values);
+	ClassDB::bind_method(D_METHOD("get_vector2_values"), &UsdGeomPrimvar::get_vector2_values);
+	ClassDB::bind_method(D_METHOD("get_float_values"), &UsdGeomPrimvar::get_float_values);
+	ClassDB::bind_method(D_METHOD("get_int_values"), &UsdGeomPrimvar::get_int_values);
+	ClassDB::bind_method(D_METHOD("get_color_values"), &UsdGeomPrimvar::get_color_values);
 	ClassDB::bind_method(D_METHOD("get_interpolation"), &UsdGeomPrimvar::get_interpolation);
 	ClassDB::bind_method(D_METHOD("set_interpolation", "interpolation"), &UsdGeomPrimvar::set_interpolation);
 	ClassDB::bind_method(D_METHOD("get_element_size"), &UsdGeomPrimvar::get_element_size);
@@ -148,14 +199,8 @@ UsdPrimType::Type UsdPrimValueXform::get_type() const {
 	return UsdPrimType::USD_PRIM_TYPE_XFORM;
 }
 
-Transform3D UsdPrimValueXform::get_transform() const {
-	const tinyusdz::Xform *xform = get_typed_prim<tinyusdz::Xform>(_prim);
-	if (!xform) {
-		return Transform3D();
-	}
-
+static Transform3D xform_ops_to_transform(const std::vector<tinyusdz::XformOp> &transforms) {
 	Transform3D result_transform;
-	const std::vector<tinyusdz::XformOp> &transforms = xform->xformOps;
 
 	for (const auto &transform : transforms) {
 		switch (transform.op_type) {
@@ -236,6 +281,15 @@ Transform3D UsdPrimValueXform::get_transform() const {
 	return result_transform;
 }
 
+Transform3D UsdPrimValueXform::get_transform() const {
+	const tinyusdz::Xform *xform = get_typed_prim<tinyusdz::Xform>(_prim);
+	if (!xform) {
+		return Transform3D();
+	}
+
+	return xform_ops_to_transform(xform->xformOps);
+}
+
 String UsdPrimValueXform::get_name() const {
 	const tinyusdz::Xform *xform = get_typed_prim<tinyusdz::Xform>(_prim);
 	if (!xform) {
@@ -446,6 +500,10 @@ UsdPrimType::Type UsdPrimValueGeomMesh::get_type() const {
 }
 
 PackedVector3Array UsdPrimValueGeomMesh::get_points() const {
+	return get_transformed_points(Transform3D());
+}
+
+PackedVector3Array UsdPrimValueGeomMesh::get_transformed_points(const Transform3D &transform) const {
 	PackedVector3Array godot_points;
 
 	const tinyusdz::GeomMesh *mesh = get_typed_prim<tinyusdz::GeomMesh>(_prim);
@@ -453,15 +511,33 @@ PackedVector3Array UsdPrimValueGeomMesh::get_points() const {
 		return godot_points;
 	}
 
-	auto points = mesh->get_points();
-	godot_points.resize(points.size());
-	for (size_t i = 0; i < points.size(); i++) {
-		godot_points[i] = Vector3(points[i][0], points[i][1], points[i][2]);
-	}
+	static_assert(sizeof(tinyusdz::value::point3f) == 3 * sizeof(float), "point3f must be packed xyz floats");
+	const std::vector<tinyusdz::value::point3f> points = mesh->get_points();
+	transform_points(reinterpret_cast<const float *>(points.data()), int64_t(points.size()), transform, godot_points);
 
 	return godot_points;
 }
 
+// primvars:normals takes precedence over the normals attribute and can be indexed, the returned values are flattened
+static std::vector<tinyusdz::value::normal3f> get_mesh_normals(const tinyusdz::Stage &stage, const tinyusdz::GeomMesh *mesh, tinyusdz::Interpolation *r_interpolation) {
+	std::vector<tinyusdz::value::normal3f> normals;
+	if (mesh->props.count("primvars:normals")) {
+		tinyusdz::GeomPrimvar primvar;
+		std::string err;
+		if (tinyusdz::tydra::GetGeomPrimvar(stage, mesh, "normals", &primvar, &err)) {
+			*r_interpolation = primvar.get_interpolation();
+			if (!primvar.flatten_with_indices(&normals, &err)) {
+				WARN_PRINT(String("Failed to read primvars:normals: ") + err.c_str());
+				normals.clear();
+			}
+			return normals;
+		}
+	}
+
+	*r_interpolation = mesh->get_normalsInterpolation();
+	return mesh->get_normals();
+}
+
 PackedVector3Array UsdPrimValueGeomMesh::get_normals() const {
 	PackedVector3Array godot_normals;
 
@@ -470,7 +546,8 @@ PackedVector3Array UsdPrimValueGeomMesh::get_normals() const {
 		return godot_normals;
 	}
 
-	auto normals = mesh->get_normals();
+	tinyusdz::Interpolation interpolation;
+	auto normals = get_mesh_normals(*_stage, mesh, &interpolation);
 	godot_normals.resize(normals.size());
 	for (size_t i = 0; i < normals.size(); i++) {
 		godot_normals[i] = Vector3(normals[i][0], normals[i][1], normals[i][2]);
@@ -479,6 +556,127 @@ PackedVector3Array UsdPrimValueGeomMesh::get_normals() const {
 	return godot_normals;
 }
 
+UsdGeomPrimvar::Interpolation UsdPrimValueGeomMesh::get_normals_interpolation() const {
+	const tinyusdz::GeomMesh *mesh = get_typed_prim<tinyusdz::GeomMesh>(_prim);
+	if (!mesh) {
+		return UsdGeomPrimvar::INVALID;
+	}
+
+	if (mesh->props.count("primvars:normals")) {
+		tinyusdz::GeomPrimvar primvar;
+		std::string err;
+		if (tinyusdz::tydra::GetGeomPrimvar(*_stage, mesh, "normals", &primvar, &err)) {
+			return UsdGeomPrimvar::interpolation_from_internal(primvar.get_interpolation());
+		}
+	}
+	return UsdGeomPrimvar::interpolation_from_internal(mesh->get_normalsInterpolation());
+}
+
+int64_t UsdPrimValueGeomMesh::get_geometry_hash(const String &relative_to) const {
+	const tinyusdz::GeomMesh *mesh = get_typed_prim<tinyusdz::GeomMesh>(_prim);
+	if (!mesh) {
+		return 0;
+	}
+
+	// Hashes the raw tinyusdz buffers, converting them first would cost as much as the conversion this avoids
+	ContentHasher hasher;
+	const std::vector<tinyusdz::value::point3f> points = mesh->get_points();
+	tinyusdz::Interpolation normals_interpolation;
+	const std::vector<tinyusdz::value::normal3f> normals = get_mesh_normals(*_stage, mesh, &normals_interpolation);
+	const std::vector<int32_t> &face_vertex_counts = mesh->get_faceVertexCounts();
+	const std::vector<int32_t> &face_vertex_indices = mesh->get_faceVertexIndices();
+	hasher.add_buffer(points.data(), points.size() * sizeof(tinyusdz::value::point3f));
+	hasher.add_buffer(normals.data(), normals.size() * sizeof(tinyusdz::value::normal3f));
+	hasher.add(uint64_t(normals_interpolation));
+	hasher.add_buffer(face_vertex_counts.data(), face_vertex_counts.size() * sizeof(int32_t));
+	hasher.add_buffer(face_vertex_indices.data(), face_vertex_indices.size() * sizeof(int32_t));
+
+	// Subdivision tags change the refined shape, so meshes that only differ in them must not share
+	hasher.add(uint64_t(get_subdivision_scheme()));
+	hasher.add(uint64_t(get_interpolate_boundary()));
+	hasher.add(uint64_t(get_face_varying_linear_interpolation()));
+	const PackedInt32Array subdiv_int_arrays[] = { get_crease_indices(), get_crease_lengths(), get_corner_indices(), get_hole_indices() };
+	for (const PackedInt32Array &values : subdiv_int_arrays) {
+		hasher.add(uint64_t(values.size()));
+		hasher.add_buffer(values.ptr(), values.size() * sizeof(int32_t));
+	}
+	const PackedFloat32Array subdiv_float_arrays[] = { get_crease_sharpnesses(), get_corner_sharpnesses() };
+	for (const PackedFloat32Array &values : subdiv_float_arrays) {
+		hasher.add(uint64_t(values.size()));
+		hasher.add_buffer(values.ptr(), values.size() * sizeof(float));
+	}
+
+	for (int i = 0; i < PRIMVAR_INVALID; i++) {
+		const PrimVarType type = static_cast<PrimVarType>(i);
+		if (!has_primvar(type)) {
+			hasher.add(0);
+			continue;
+		}
+
+		Ref<UsdGeomPrimvar> primvar = get_primvar(type);
+		hasher.add(primvar->get_interpolation());
+		hasher.add(primvar->get_element_size());
+
+		const PackedInt32Array indices = primvar->get_indices();
+		hasher.add_buffer(indices.ptr(), indices.size() * sizeof(int32_t));
+
+		switch (type) {
+			case PRIMVAR_TEX_UV:
+			case PRIMVAR_TEX_UV2: {
+				const PackedVector2Array values = primvar->get_vector2_values();
+				hasher.add_buffer(values.ptr(), values.size() * sizeof(Vector2));
+				break;
+			}
+			case PRIMVAR_COLOR: {
+				const PackedColorArray values = primvar->get_color_values();
+				hasher.add_buffer(values.ptr(), values.size() * sizeof(Color));
+				break;
+			}
+			case PRIMVAR_BONES: {
+				const PackedInt32Array values = primvar->get_int_values();
+				hasher.add_buffer(values.ptr(), values.size() * sizeof(int32_t));
+				break;
+			}
+			case PRIMVAR_WEIGHTS: {
+				const PackedFloat32Array values = primvar->get_float_values();
+				hasher.add_buffer(values.ptr(), values.size() * sizeof(float));
+				break;
+			}
+			default:
+				break;
+		}
+	}
+
+	// Baked into the points of skinned meshes
+	if (has_geom_bind_transform()) {
+		const Transform3D geom_bind_transform = get_geom_bind_transform();
+		hasher.add_buffer(&geom_bind_transform, sizeof(Transform3D));
+	}
+
+	const Ref<UsdGeomMeshMaterialMap> material_map = get_material_map();
+	const PackedInt32Array face_material_indices = material_map->get_face_material_indices();
+	hasher.add_buffer(face_material_indices.ptr(), face_material_indices.size() * sizeof(int32_t));
+
+	const TypedArray<UsdPath> materials = material_map->get_materials();
+	for (int i = 0; i < materials.size(); i++) {
+		const Ref<UsdPath> material_path = materials[i];
+		String path_string = material_path.is_valid() ? material_path->full_path() : String();
+		if (!relative_to.is_empty() && path_string.begins_with(relative_to + "/")) {
+			path_string = path_string.substr(relative_to.length());
+		}
+		const CharString path = path_string.utf8();
+		hasher.add_buffer(path.get_data(), path.length());
+	}
+
+	const PackedStringArray surface_names = material_map->get_surface_names();
+	for (int i = 0; i < surface_names.size(); i++) {
+		const CharString name = surface_names[i].utf8();
+		hasher.add_buffer(name.get_data(), name.length());
+	}
+
+	return static_cast<int64_t>(hasher.get());
+}
+
 String UsdPrimValueGeomMesh::get_primvar_name(const UsdPrimValueGeomMesh::PrimVarType type) const {
 	const tinyusdz::GeomMesh *mesh = get_typed_prim<tinyusdz::GeomMesh>(_prim);
 	if (!mesh) {
@@ -530,46 +728,43 @@ Ref<UsdGeomPrimvar> UsdPrimValueGeomMesh::get_primvar(const UsdPrimValueGeomMesh
 		result->set_element_size(primvar.get_elementSize());
 	}
 
-	Array values;
 	switch (type) {
 		case PRIMVAR_TEX_UV:
 		case PRIMVAR_TEX_UV2: {
 			std::vector<tinyusdz::value::texcoord2f> value;
 			success = primvar.get_value(&value, &err);
 			ERR_FAIL_COND_V_MSG(!success, result, String("Failed to get UV value: ") + err.c_str());
-			values = to_variant(value);
+			result->set_packed_values(to_packed_array(value));
 			break;
 		}
 		case PRIMVAR_COLOR: {
 			std::vector<tinyusdz::value::color3f> value;
 			success = primvar.get_value(&value, &err);
 			ERR_FAIL_COND_V_MSG(!success, result, String("Failed to get color value: ") + err.c_str());
-			values = to_variant(value);
+			result->set_packed_values(to_packed_array(value));
 			break;
 		}
 		case PRIMVAR_BONES: {
 			std::vector<int32_t> value;
 			success = primvar.get_value(&value, &err);
 			ERR_FAIL_COND_V_MSG(!success, result, String("Failed to get bone indices: ") + err.c_str());
-			values = to_variant(value);
+			result->set_packed_values(to_packed_array(value));
 			break;
 		}
 		case PRIMVAR_WEIGHTS: {
 			std::vector<float> value;
 			success = primvar.get_value(&value, &err);
 			ERR_FAIL_COND_V_MSG(!success, result, String("Failed to get bone weights: ") + err.c_str());
-			values = to_variant(value);
+			result->set_packed_values(to_packed_array(value));
 			break;
 		}
 		default:
 			ERR_FAIL_V_MSG(result, "Unsupported primvar type");
 			break;
 	}
-	result->set_values(values);
 
 	if (primvar.has_indices()) {
-		std::vector<int32_t> indices_vec = primvar.get_default_indices();
-		result->set_indices(to_variant(indices_vec));
+		result->set_indices(to_packed_array(primvar.get_default_indices()));
 	}
 
 	return result;
@@ -627,10 +822,130 @@ String UsdPrimValueGeomMesh::get_name() const {
 	return String(mesh->name.c_str());
 }
 
+UsdPrimValueGeomMesh::SubdivisionScheme UsdPrimValueGeomMesh::get_subdivision_scheme() const {
+	const tinyusdz::GeomMesh *mesh = get_typed_prim<tinyusdz::GeomMesh>(_prim);
+	if (!mesh) {
+		return SUBDIVISION_SCHEME_NONE;
+	}
+
+	switch (mesh->subdivisionScheme.get_value()) {
+		case tinyusdz::GeomMesh::SubdivisionScheme::CatmullClark:
+			return SUBDIVISION_SCHEME_CATMULL_CLARK;
+		case tinyusdz::GeomMesh::SubdivisionScheme::Loop:
+			return SUBDIVISION_SCHEME_LOOP;
+		case tinyusdz::GeomMesh::SubdivisionScheme::Bilinear:
+			return SUBDIVISION_SCHEME_BILINEAR;
+		default:
+			return SUBDIVISION_SCHEME_NONE;
+	}
+}
+
+UsdPrimValueGeomMesh::InterpolateBoundary UsdPrimValueGeomMesh::get_interpolate_boundary() const {
+	const tinyusdz::GeomMesh *mesh = get_typed_prim<tinyusdz::GeomMesh>(_prim);
+	if (!mesh) {
+		return INTERPOLATE_BOUNDARY_EDGE_AND_CORNER;
+	}
+
+	switch (get_default_value(mesh->interpolateBoundary, tinyusdz::GeomMesh::InterpolateBoundary::EdgeAndCorner)) {
+		case tinyusdz::GeomMesh::InterpolateBoundary::InterpolateBoundaryNone:
+			return INTERPOLATE_BOUNDARY_NONE;
+		case tinyusdz::GeomMesh::InterpolateBoundary::EdgeOnly:
+			return INTERPOLATE_BOUNDARY_EDGE_ONLY;
+		default:
+			return INTERPOLATE_BOUNDARY_EDGE_AND_CORNER;
+	}
+}
+
+UsdPrimValueGeomMesh::FaceVaryingLinearInterpolation UsdPrimValueGeomMesh::get_face_varying_linear_interpolation() const {
+	const tinyusdz::GeomMesh *mesh = get_typed_prim<tinyusdz::GeomMesh>(_prim);
+	if (!mesh) {
+		return FACE_VARYING_LINEAR_CORNERS_PLUS1;
+	}
+
+	switch (get_default_value(mesh->faceVaryingLinearInterpolation, tinyusdz::GeomMesh::FaceVaryingLinearInterpolation::CornersPlus1)) {
+		case tinyusdz::GeomMesh::FaceVaryingLinearInterpolation::FaceVaryingLinearInterpolationNone:
+			return FACE_VARYING_LINEAR_NONE;
+		case tinyusdz::GeomMesh::FaceVaryingLinearInterpolation::CornersOnly:
+			return FACE_VARYING_LINEAR_CORNERS_ONLY;
+		case tinyusdz::GeomMesh::FaceVaryingLinearInterpolation::CornersPlus2:
+			return FACE_VARYING_LINEAR_CORNERS_PLUS2;
+		case tinyusdz::GeomMesh::FaceVaryingLinearInterpolation::Boundaries:
+			return FACE_VARYING_LINEAR_BOUNDARIES;
+		case tinyusdz::GeomMesh::FaceVaryingLinearInterpolation::All:
+			return FACE_VARYING_LINEAR_ALL;
+		default:
+			return FACE_VARYING_LINEAR_CORNERS_PLUS1;
+	}
+}
+
+PackedInt32Array UsdPrimValueGeomMesh::get_crease_indices() const {
+	const tinyusdz::GeomMesh *mesh = get_typed_prim<tinyusdz::GeomMesh>(_prim);
+	std::vector<int32_t> values;
+	if (!mesh || !get_default_value(mesh->creaseIndices, &values)) {
+		return PackedInt32Array();
+	}
+	return to_packed_array(values);
+}
+
+PackedInt32Array UsdPrimValueGeomMesh::get_crease_lengths() const {
+	const tinyusdz::GeomMesh *mesh = get_typed_prim<tinyusdz::GeomMesh>(_prim);
+	std::vector<int32_t> values;
+	if (!mesh || !get_default_value(mesh->creaseLengths, &values)) {
+		return PackedInt32Array();
+	}
+	return to_packed_array(values);
+}
+
+PackedFloat32Array UsdPrimValueGeomMesh::get_crease_sharpnesses() const {
+	const tinyusdz::GeomMesh *mesh = get_typed_prim<tinyusdz::GeomMesh>(_prim);
+	std::vector<float> values;
+	if (!mesh || !get_default_value(mesh->creaseSharpnesses, &values)) {
+		return PackedFloat32Array();
+	}
+	return to_packed_array(values);
+}
+
+PackedInt32Array UsdPrimValueGeomMesh::get_corner_indices() const {
+	const tinyusdz::GeomMesh *mesh = get_typed_prim<tinyusdz::GeomMesh>(_prim);
+	std::vector<int32_t> values;
+	if (!mesh || !get_default_value(mesh->cornerIndices, &values)) {
+		return PackedInt32Array();
+	}
+	return to_packed_array(values);
+}
+
+PackedFloat32Array UsdPrimValueGeomMesh::get_corner_sharpnesses() const {
+	const tinyusdz::GeomMesh *mesh = get_typed_prim<tinyusdz::GeomMesh>(_prim);
+	std::vector<float> values;
+	if (!mesh || !get_default_value(mesh->cornerSharpnesses, &values)) {
+		return PackedFloat32Array();
+	}
+	return to_packed_array(values);
+}
+
+PackedInt32Array UsdPrimValueGeomMesh::get_hole_indices() const {
+	const tinyusdz::GeomMesh *mesh = get_typed_prim<tinyusdz::GeomMesh>(_prim);
+	std::vector<int32_t> values;
+	if (!mesh || !mesh->holeIndices.has_value() || !mesh->holeIndices.get_value(&values)) {
+		return PackedInt32Array();
+	}
+	return to_packed_array(values);
+}
+
 size_t UsdPrimValueGeomMesh::get_face_count() const {
 	return get_face_vertex_counts().size();
 }
 
+size_t UsdPrimValueGeomMesh::get_point_count() const {
+	const tinyusdz::GeomMesh *mesh = get_typed_prim<tinyusdz::GeomMesh>(_prim);
+	return mesh ? mesh->get_points().size() : 0;
+}
+
+size_t UsdPrimValueGeomMesh::get_face_vertex_index_count() const {
+	const tinyusdz::GeomMesh *mesh = get_typed_prim<tinyusdz::GeomMesh>(_prim);
+	return mesh ? mesh->get_faceVertexIndices().size() : 0;
+}
+
 PackedInt32Array UsdPrimValueGeomMesh::get_face_vertex_counts() const {
 	const tinyusdz::GeomMesh *mesh = get_typed_prim<tinyusdz::GeomMesh>(_prim);
 	if (!mesh) {
@@ -876,7 +1191,10 @@ String UsdPrimValueGeomMesh::_to_string() const {
 void UsdPrimValueGeomMesh::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("get_name"), &UsdPrimValueGeomMesh::get_name);
 	ClassDB::bind_method(D_METHOD("get_points"), &UsdPrimValueGeomMesh::get_points);
+	ClassDB::bind_method(D_METHOD("get_transformed_points", "transform"), &UsdPrimValueGeomMesh::get_transformed_points);
+	ClassDB::bind_method(D_METHOD("get_geometry_hash", "relative_to"), &UsdPrimValueGeomMesh::get_geometry_hash, DEFVAL(String()));
 	ClassDB::bind_method(D_METHOD("get_normals"), &UsdPrimValueGeomMesh::get_normals);
+	ClassDB::bind_method(D_METHOD("get_normals_interpolation"), &UsdPrimValueGeomMesh::get_normals_interpolation);
 	ClassDB::bind_method(D_METHOD("get_face_count"), &UsdPrimValueGeomMesh::get_face_count);
 	ClassDB::bind_method(D_METHOD("get_face_vertex_counts"), &UsdPrimValueGeomMesh::get_face_vertex_counts);
 	ClassDB::bind_method(D_METHOD("get_face_vertex_indices"), &UsdPrimValueGeomMesh::get_face_vertex_indices);
@@ -891,6 +1209,15 @@ void UsdPrimValueGeomMesh::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("get_skeleton"), &UsdPrimValueGeomMesh::get_skeleton);
 	ClassDB::bind_method(D_METHOD("has_geom_bind_transform"), &UsdPrimValueGeomMesh::has_geom_bind_transform);
 	ClassDB::bind_method(D_METHOD("get_geom_bind_transform"), &UsdPrimValueGeomMesh::get_geom_bind_transform);
+	ClassDB::bind_method(D_METHOD("get_subdivision_scheme"), &UsdPrimValueGeomMesh::get_subdivision_scheme);
+	ClassDB::bind_method(D_METHOD("get_interpolate_boundary"), &UsdPrimValueGeomMesh::get_interpolate_boundary);
+	ClassDB::bind_method(D_METHOD("get_face_varying_linear_interpolation"), &UsdPrimValueGeomMesh::get_face_varying_linear_interpolation);
+	ClassDB::bind_method(D_METHOD("get_crease_indices"), &UsdPrimValueGeomMesh::get_crease_indices);
+	ClassDB::bind_method(D_METHOD("get_crease_lengths"), &UsdPrimValueGeomMesh::get_crease_lengths);
+	ClassDB::bind_method(D_METHOD("get_crease_sharpnesses"), &UsdPrimValueGeomMesh::get_crease_sharpnesses);
+	ClassDB::bind_method(D_METHOD("get_corner_indices"), &UsdPrimValueGeomMesh::get_corner_indices);
+	ClassDB::bind_method(D_METHOD("get_corner_sharpnesses"), &UsdPrimValueGeomMesh::get_corner_sharpnesses);
+	ClassDB::bind_method(D_METHOD("get_hole_indices"), &UsdPrimValueGeomMesh::get_hole_indices);
 
 	ClassDB::bind_static_method("UsdPrimValueGeomMesh", D_METHOD("primvar_type_from_string", "type"), &UsdPrimValueGeomMesh::primvar_type_from_string);
 	ClassDB::bind_static_method("UsdPrimValueGeomMesh", D_METHOD("primvar_type_to_string", "type"), &UsdPrimValueGeomMesh::primvar_type_to_string);
@@ -904,4 +1231,145 @@ void UsdPrimValueGeomMesh::_bind_methods() {
 	BIND_ENUM_CONSTANT(PRIMVAR_COLOR);
 	BIND_ENUM_CONSTANT(PRIMVAR_BONES);
 	BIND_ENUM_CONSTANT(PRIMVAR_WEIGHTS);
+
+	BIND_ENUM_CONSTANT(SUBDIVISION_SCHEME_NONE);
+	BIND_ENUM_CONSTANT(SUBDIVISION_SCHEME_CATMULL_CLARK);
+	BIND_ENUM_CONSTANT(SUBDIVISION_SCHEME_LOOP);
+	BIND_ENUM_CONSTANT(SUBDIVISION_SCHEME_BILINEAR);
+
+	BIND_ENUM_CONSTANT(INTERPOLATE_BOUNDARY_NONE);
+	BIND_ENUM_CONSTANT(INTERPOLATE_BOUNDARY_EDGE_ONLY);
+	BIND_ENUM_CONSTANT(INTERPOLATE_BOUNDARY_EDGE_AND_CORNER);
+
+	BIND_ENUM_CONSTANT(FACE_VARYING_LINEAR_NONE);
+	BIND_ENUM_CONSTANT(FACE_VARYING_LINEAR_CORNERS_ONLY);
+	BIND_ENUM_CONSTANT(FACE_VARYING_LINEAR_CORNERS_PLUS1);
+	BIND_ENUM_CONSTANT(FACE_VARYING_LINEAR_CORNERS_PLUS2);
+	BIND_ENUM_CONSTANT(FACE_VARYING_LINEAR_BOUNDARIES);
+	BIND_ENUM_CONSTANT(FACE_VARYING_LINEAR_ALL);
+}
+
+UsdPrimType::Type UsdPrimValuePointInstancer::get_type() const {
+	return UsdPrimType::USD_PRIM_TYPE_POINT_INSTANCER;
+}
+
+String UsdPrimValuePointInstancer::get_name() const {
+	const tinyusdz::PointInstancer *instancer = get_typed_prim<tinyusdz::PointInstancer>(_prim);
+	if (!instancer) {
+		return String();
+	}
+
+	return String(instancer->name.c_str());
+}
+
+Transform3D UsdPrimValuePointInstancer::get_transform() const {
+	const tinyusdz::PointInstancer *instancer = get_typed_prim<tinyusdz::PointInstancer>(_prim);
+	if (!instancer) {
+		return Transform3D();
+	}
+
+	return xform_ops_to_transform(instancer->xformOps);
+}
+
+TypedArray<UsdPath> UsdPrimValuePointInstancer::get_prototypes() const {
+	TypedArray<UsdPath> prototypes;
+
+	const tinyusdz::PointInstancer *instancer = get_typed_prim<tinyusdz::PointInstancer>(_prim);
+	if (!instancer || !instancer->prototypes) {
+		return prototypes;
+	}
+
+	const tinyusdz::Relationship &relationship = instancer->prototypes.value();
+	if (relationship.is_path()) {
+		prototypes.push_back(UsdPath::create(relationship.targetPath));
+	} else if (relationship.is_pathvector()) {
+		for (const tinyusdz::Path &path : relationship.targetPathVector) {
+			prototypes.push_back(UsdPath::create(path));
+		}
+	}
+
+	return prototypes;
+}
+
+PackedInt32Array UsdPrimValuePointInstancer::get_proto_indices() const {
+	const tinyusdz::PointInstancer *instancer = get_typed_prim<tinyusdz::PointInstancer>(_prim);
+	std::vector<int32_t> proto_indices;
+	if (!instancer || !get_default_value(instancer->protoIndices, &proto_indices)) {
+		return PackedInt32Array();
+	}
+
+	return to_packed_array(proto_indices);
+}
+
+PackedVector3Array UsdPrimValuePointInstancer::get_positions() const {
+	PackedVector3Array godot_positions;
+
+	const tinyusdz::PointInstancer *instancer = get_typed_prim<tinyusdz::PointInstancer>(_prim);
+	std::vector<tinyusdz::value::point3f> positions;
+	if (!instancer || !get_default_value(instancer->positions, &positions)) {
+		return godot_positions;
+	}
+
+	godot_positions.resize(positions.size());
+	Vector3 *positions_ptr = godot_positions.ptrw();
+	for (size_t i = 0; i < positions.size(); i++) {
+		positions_ptr[i] = Vector3(positions[i][0], positions[i][1], positions[i][2]);
+	}
+
+	return godot_positions;
+}
+
+PackedVector4Array UsdPrimValuePointInstancer::get_orientations() const {
+	PackedVector4Array godot_orientations;
+
+	const tinyusdz::PointInstancer *instancer = get_typed_prim<tinyusdz::PointInstancer>(_prim);
+	std::vector<tinyusdz::value::quath> orientations;
+	if (!instancer || !get_default_value(instancer->orientations, &orientations)) {
+		return godot_orientations;
+	}
+
+	godot_orientations.resize(orientations.size());
+	Vector4 *orientations_ptr = godot_orientations.ptrw();
+	for (size_t i = 0; i < orientations.size(); i++) {
+		const tinyusdz::value::quath &orientation = orientations[i];
+		orientations_ptr[i] = Vector4(
+				tinyusdz::value::half_to_float(orientation.imag[0]),
+				tinyusdz::value::half_to_float(orientation.imag[1]),
+				tinyusdz::value::half_to_float(orientation.imag[2]),
+				tinyusdz::value::half_to_float(orientation.real));
+	}
+
+	return godot_orientations;
+}
+
+PackedVector3Array UsdPrimValuePointInstancer::get_scales() const {
+	PackedVector3Array godot_scales;
+
+	const tinyusdz::PointInstancer *instancer = get_typed_prim<tinyusdz::PointInstancer>(_prim);
+	std::vector<tinyusdz::value::float3> scales;
+	if (!instancer || !get_default_value(instancer->scales, &scales)) {
+		return godot_scales;
+	}
+
+	godot_scales.resize(scales.size());
+	Vector3 *scales_ptr = godot_scales.ptrw();
+	for (size_t i = 0; i < scales.size(); i++) {
+		scales_ptr[i] = Vector3(scales[i][0], scales[i][1], scales[i][2]);
+	}
+
+	return godot_scales;
+}
+
+String UsdPrimValuePointInstancer::_to_string() const {
+	return "UsdPrimValuePointInstancer(name: \"" + get_name() + "\", instances: " + String::num_int64(get_proto_indices().size()) + ", prototypes: " + String::num_int64(get_prototypes().size()) + ")";
+}
+
+void UsdPrimValuePointInstancer::_bind_methods() {
+	ClassDB::bind_method(D_METHOD("get_name"), &UsdPrimValuePointInstancer::get_name);
+	ClassDB::bind_method(D_METHOD("get_transform"), &UsdPrimValuePointInstancer::get_transform);
+	ClassDB::bind_method(D_METHOD("get_prototypes"), &UsdPrimValuePointInstancer::get_prototypes);
+	ClassDB::bind_method(D_METHOD("get_proto_indices"), &UsdPrimValuePointInstancer::get_proto_indices);
+	ClassDB::bind_method(D_METHOD("get_positions"), &UsdPrimValuePointInstancer::get_positions);
+	ClassDB::bind_method(D_METHOD("get_orientations"), &UsdPrimValuePointInstancer::get_orientations);
+	ClassDB::bind_method(D_METHOD("get_scales"), &UsdPrimValuePointInstancer::get_scales);
 }
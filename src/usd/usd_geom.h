@@ -4,10 +4,13 @@
 #include <godot_cpp/core/class_db.hpp>
 
 #include <godot_cpp/core/binder_common.hpp>
+#include <godot_cpp/variant/packed_color_array.hpp>
+#include <godot_cpp/variant/packed_float32_array.hpp>
 #include <godot_cpp/variant/packed_int32_array.hpp>
 #include <godot_cpp/variant/packed_string_array.hpp>
 #include <godot_cpp/variant/packed_vector2_array.hpp>
 #include <godot_cpp/variant/packed_vector3_array.hpp>
+#include <godot_cpp/variant/packed_vector4_array.hpp>
 #include <godot_cpp/variant/transform3d.hpp>
 #include <godot_cpp/variant/typed_array.hpp>
 
@@ -36,9 +39,18 @@ public:
 	godot::String get_name() const;
 	void set_name(const godot::String &name);
 
+	/// Boxes every value into a Variant, prefer the typed getters below from C++
 	godot::Array get_values() const;
 	void set_values(const godot::Array &values);
 
+	/// Typed access to the values without boxing, converts if the values are stored as another type
+	godot::PackedVector2Array get_vector2_values() const;
+	godot::PackedFloat32Array get_float_values() const;
+	godot::PackedInt32Array get_int_values() const;
+	godot::PackedColorArray get_color_values() const;
+	/// values has to be one of the packed array types above
+	void set_packed_values(const godot::Variant &values);
+
 	Interpolation get_interpolation() const;
 	void set_interpolation(Interpolation interpolation);
 
@@ -57,7 +69,8 @@ protected:
 
 private:
 	godot::String _name;
-	godot::Array _values;
+	/// Packed array of the primvar's type, or an Array if set from a script
+	godot::Variant _values;
 	Interpolation _interpolation = INVALID;
 	int _element_size = 1;
 	godot::PackedInt32Array _indices;
@@ -164,6 +177,28 @@ public:
 		PRIMVAR_INVALID,
 	};
 
+	enum SubdivisionScheme {
+		SUBDIVISION_SCHEME_NONE,
+		SUBDIVISION_SCHEME_CATMULL_CLARK,
+		SUBDIVISION_SCHEME_LOOP,
+		SUBDIVISION_SCHEME_BILINEAR,
+	};
+
+	enum InterpolateBoundary {
+		INTERPOLATE_BOUNDARY_NONE,
+		INTERPOLATE_BOUNDARY_EDGE_ONLY,
+		INTERPOLATE_BOUNDARY_EDGE_AND_CORNER,
+	};
+
+	enum FaceVaryingLinearInterpolation {
+		FACE_VARYING_LINEAR_NONE,
+		FACE_VARYING_LINEAR_CORNERS_ONLY,
+		FACE_VARYING_LINEAR_CORNERS_PLUS1,
+		FACE_VARYING_LINEAR_CORNERS_PLUS2,
+		FACE_VARYING_LINEAR_BOUNDARIES,
+		FACE_VARYING_LINEAR_ALL,
+	};
+
 	static PrimVarType primvar_type_from_string(const godot::String &name);
 	static godot::PackedStringArray primvar_type_to_string(const PrimVarType type);
 
@@ -176,14 +211,37 @@ public:
 	bool has_geom_bind_transform() const;
 	godot::Transform3D get_geom_bind_transform() const;
 
+	// Subdivision surface attributes, USD defaults to catmullClark when subdivisionScheme isn't authored
+	SubdivisionScheme get_subdivision_scheme() const;
+	InterpolateBoundary get_interpolate_boundary() const;
+	FaceVaryingLinearInterpolation get_face_varying_linear_interpolation() const;
+	godot::PackedInt32Array get_crease_indices() const;
+	godot::PackedInt32Array get_crease_lengths() const;
+	godot::PackedFloat32Array get_crease_sharpnesses() const;
+	godot::PackedInt32Array get_corner_indices() const;
+	godot::PackedFloat32Array get_corner_sharpnesses() const;
+	godot::PackedInt32Array get_hole_indices() const;
+
 	virtual UsdPrimType::Type get_type() const override;
 
 	godot::String get_name() const;
 	godot::PackedVector3Array get_points() const;
+	/// Points with transform applied in the same pass that reads them, e.g. the one from get_points_transform
+	godot::PackedVector3Array get_transformed_points(const godot::Transform3D &transform) const;
+	/// Authored normals, flattened if primvars:normals is indexed
 	godot::PackedVector3Array get_normals() const;
+	/// How get_normals maps to the mesh, only meaningful if it isn't empty
+	UsdGeomPrimvar::Interpolation get_normals_interpolation() const;
+	/// Hash of everything that ends up in the converted mesh: points, normals, topology, primvars and material bindings.
+	/// Meshes with the same hash convert to the same ImporterMesh. Material paths below relative_to are hashed relative to it,
+	/// so the meshes of different instances of one prototype hash the same
+	int64_t get_geometry_hash(const godot::String &relative_to = godot::String()) const;
 	size_t get_face_count() const;
 	godot::PackedInt32Array get_face_vertex_counts() const;
 	godot::PackedInt32Array get_face_vertex_indices() const;
+	/// Sizes of the points and faceVertexIndices without converting them
+	size_t get_point_count() const;
+	size_t get_face_vertex_index_count() const;
 
 	bool has_directly_bound_material() const;
 	godot::Ref<UsdPath> get_directly_bound_material() const;
@@ -198,3 +256,29 @@ public:
 };
 
 VARIANT_ENUM_CAST(UsdPrimValueGeomMesh::PrimVarType);
+VARIANT_ENUM_CAST(UsdPrimValueGeomMesh::SubdivisionScheme);
+VARIANT_ENUM_CAST(UsdPrimValueGeomMesh::InterpolateBoundary);
+VARIANT_ENUM_CAST(UsdPrimValueGeomMesh::FaceVaryingLinearInterpolation);
+
+/// Scatters copies of its prototypes, one transform per entry of positions
+class UsdPrimValuePointInstancer : public UsdPrimValue {
+	GDCLASS(UsdPrimValuePointInstancer, UsdPrimValue);
+
+protected:
+	static void _bind_methods();
+
+public:
+	virtual UsdPrimType::Type get_type() const override;
+	godot::String _to_string() const;
+
+	godot::String get_name() const;
+	godot::Transform3D get_transform() const;
+
+	godot::TypedArray<UsdPath> get_prototypes() const;
+	godot::PackedInt32Array get_proto_indices() const;
+	godot::PackedVector3Array get_positions() const;
+	/// Quaternions as (x, y, z, w), empty if not authored
+	godot::PackedVector4Array get_orientations() const;
+	/// Empty if not authored
+	godot::PackedVector3Array get_scales() const;
+};
@@ -24,27 +24,39 @@ UsdPrimType::Type UsdPrim::get_prim_type(const tinyusdz::Prim *prim) {
 			return UsdPrimType::USD_PRIM_TYPE_SKELETON;
 		case tinyusdz::value::TYPE_ID_SKEL_ROOT:
 			return UsdPrimType::USD_PRIM_TYPE_SKELETON_ROOT;
+		case tinyusdz::value::TYPE_ID_MODEL:
+			return UsdPrimType::USD_PRIM_TYPE_MODEL;
+		case tinyusdz::value::TYPE_ID_GEOM_POINT_INSTANCER:
+			return UsdPrimType::USD_PRIM_TYPE_POINT_INSTANCER;
 		default:
 			return UsdPrimType::USD_PRIM_TYPE_UNKNOWN;
 	}
 }
 
-Ref<UsdPrim> UsdPrim::create(std::shared_ptr<tinyusdz::Stage> stage, const tinyusdz::Path &path) {
+Ref<UsdPrim> UsdPrim::create(std::shared_ptr<tinyusdz::Stage> stage, const tinyusdz::Path &path, const tinyusdz::Prim *prim) {
 	if (!stage) {
 		return Ref<UsdPrim>();
 	}
 
-	Ref<UsdPrim> prim;
-	prim.instantiate();
-	prim->_stage = stage;
-	prim->_path.instantiate();
-	prim->_path->set_path(path);
-	return prim;
+	Ref<UsdPrim> usd_prim;
+	usd_prim.instantiate();
+	usd_prim->_stage = stage;
+	usd_prim->_path.instantiate();
+	usd_prim->_path->set_path(path);
+	usd_prim->_prim = prim;
+	return usd_prim;
+}
+
+Ref<UsdPrim> UsdPrim::create(std::shared_ptr<tinyusdz::Stage> stage, const tinyusdz::Prim *prim) {
+	ERR_FAIL_NULL_V(prim, Ref<UsdPrim>());
+	return create(stage, prim->absolute_path(), prim);
 }
 
 void UsdPrim::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("get_type_name"), &UsdPrim::get_type_name);
 	ClassDB::bind_method(D_METHOD("get_type"), &UsdPrim::get_type);
+	ClassDB::bind_method(D_METHOD("get_name"), &UsdPrim::get_name);
+	ClassDB::bind_method(D_METHOD("is_instanceable"), &UsdPrim::is_instanceable);
 	ClassDB::bind_method(D_METHOD("is_valid"), &UsdPrim::is_valid);
 	ClassDB::bind_method(D_METHOD("get_path"), &UsdPrim::get_path);
 	ClassDB::bind_method(D_METHOD("set_path", "path"), &UsdPrim::set_path);
@@ -70,8 +82,28 @@ UsdPrimType::Type UsdPrim::get_type() const {
 	return UsdPrim::get_prim_type(prim);
 }
 
+String UsdPrim::get_name() const {
+	if (!is_valid())
+		return String();
+
+	return String(_prim->element_name().c_str());
+}
+
+bool UsdPrim::is_instanceable() const {
+	if (!is_valid())
+		return false;
+
+	return _prim->metas().instanceable.value_or(false);
+}
+
 void UsdPrim::set_path(Ref<UsdPath> path) {
 	_path = path;
+
+	// Only happens from scripts, so resolving through the stage is fine here
+	_prim = nullptr;
+	if (_stage && _path.is_valid()) {
+		_prim = _stage->GetPrimAtPath(_path->get_path()).value_or(nullptr);
+	}
 }
 
 Ref<UsdPath> UsdPrim::get_path() const {
@@ -83,9 +115,9 @@ TypedArray<UsdPrim> UsdPrim::get_children() const {
 	if (!is_valid())
 		return children;
 
-	const std::vector<tinyusdz::Prim> &prims = internal_prim()->children();
+	const std::vector<tinyusdz::Prim> &prims = _prim->children();
 	for (const auto &prim : prims) {
-		children.push_back(create(_stage, prim.absolute_path()));
+		children.push_back(create(_stage, &prim));
 	}
 
 	return children;
@@ -95,17 +127,15 @@ Ref<UsdPrimValue> UsdPrim::get_value() const {
 	if (!is_valid())
 		return Ref<UsdPrimValue>();
 
-	return UsdPrimValue::create(this->internal_prim(), _stage);
+	return UsdPrimValue::create(_prim, _stage);
 }
 
 bool UsdPrim::is_valid() const {
-	return _stage != nullptr && _stage->GetPrimAtPath(_path->get_path());
+	return _stage != nullptr && _prim != nullptr;
 }
 
 const tinyusdz::Prim *UsdPrim::internal_prim() const {
-	if (!is_valid())
-		return nullptr;
-	return _stage->GetPrimAtPath(_path->get_path()).value_or(nullptr);
+	return _prim;
 }
 
 UsdPrim::UsdPrim() :
@@ -13,16 +13,24 @@ class UsdPrim : public godot::RefCounted {
 private:
 	std::shared_ptr<tinyusdz::Stage> _stage;
 	godot::Ref<UsdPath> _path;
+	/// Resolved once on creation, stays valid since _stage keeps the (read-only) stage alive
+	const tinyusdz::Prim *_prim = nullptr;
 
 protected:
 	static void _bind_methods();
 
 public:
-	static godot::Ref<UsdPrim> create(std::shared_ptr<tinyusdz::Stage> stage, const tinyusdz::Path &path);
+	/// prim is the already resolved prim at path, or nullptr if there is none
+	static godot::Ref<UsdPrim> create(std::shared_ptr<tinyusdz::Stage> stage, const tinyusdz::Path &path, const tinyusdz::Prim *prim);
+	static godot::Ref<UsdPrim> create(std::shared_ptr<tinyusdz::Stage> stage, const tinyusdz::Prim *prim);
 	static UsdPrimType::Type get_prim_type(const tinyusdz::Prim *prim);
 
 	godot::String get_type_name() const;
 	UsdPrimType::Type get_type() const;
+	godot::String get_name() const;
+
+	/// Instanceable prims share their composed children with all other instances of the same prototype
+	bool is_instanceable() const;
 
 	bool is_valid() const;
 
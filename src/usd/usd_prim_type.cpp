@@ -11,4 +11,6 @@ void UsdPrimType::_bind_methods() {
 	BIND_ENUM_CONSTANT(USD_PRIM_TYPE_SKELETON);
 	BIND_ENUM_CONSTANT(USD_PRIM_TYPE_SKELETON_ROOT);
 	BIND_ENUM_CONSTANT(USD_PRIM_TYPE_UNKNOWN);
+	BIND_ENUM_CONSTANT(USD_PRIM_TYPE_MODEL);
+	BIND_ENUM_CONSTANT(USD_PRIM_TYPE_POINT_INSTANCER);
 }
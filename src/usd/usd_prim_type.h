@@ -18,6 +18,9 @@ public:
 		USD_PRIM_TYPE_SKELETON,
 		USD_PRIM_TYPE_SKELETON_ROOT,
 		USD_PRIM_TYPE_UNKNOWN,
+		// Added after UNKNOWN so the values of the types above stay the same
+		USD_PRIM_TYPE_MODEL,
+		USD_PRIM_TYPE_POINT_INSTANCER,
 	};
 
 protected:
@@ -33,6 +33,9 @@ Ref<UsdPrimValue> UsdPrimValue::create(const tinyusdz::Prim *p_prim, std::shared
 		case UsdPrimType::USD_PRIM_TYPE_SKELETON_ROOT:
 			prim_value = create_typed<UsdPrimValueSkeletonRoot>();
 			break;
+		case UsdPrimType::USD_PRIM_TYPE_POINT_INSTANCER:
+			prim_value = create_typed<UsdPrimValuePointInstancer>();
+			break;
 		default:
 			prim_value = create_typed<UsdPrimValue>();
 	}
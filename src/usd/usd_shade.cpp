@@ -8,6 +8,7 @@
 #include <godot_cpp/classes/texture2d.hpp>
 #include <godot_cpp/templates/vector.hpp>
 #include <godot_cpp/variant/dictionary.hpp>
+#include <godot_cpp/variant/packed_byte_array.hpp>
 #include <godot_cpp/variant/packed_string_array.hpp>
 #include <godot_cpp/variant/typed_array.hpp>
 
@@ -87,6 +88,7 @@ Ref<StandardMaterial3D> create_godot_material(
 	}
 
 	if (mat_shader.normal.is_texture()) {
+		mat->set_feature(BaseMaterial3D::FEATURE_NORMAL_MAPPING, true);
 		APPLY_TEXTURE(normal, TEXTURE_NORMAL)
 	}
 
@@ -112,7 +114,48 @@ Ref<StandardMaterial3D> create_godot_material(
 	return mat;
 }
 
-Ref<UsdLoadedMaterials> extract_materials_impl(const tinyusdz::Stage &stage, const String &p_search_path = "") {
+static Ref<Image> load_image_from_buffer(const PackedByteArray &buffer, const String &extension) {
+	Ref<Image> image;
+	image.instantiate();
+
+	Error err = ERR_FILE_UNRECOGNIZED;
+	if (extension == "png") {
+		err = image->load_png_from_buffer(buffer);
+	} else if (extension == "jpg" || extension == "jpeg") {
+		err = image->load_jpg_from_buffer(buffer);
+	} else if (extension == "webp") {
+		err = image->load_webp_from_buffer(buffer);
+	} else if (extension == "tga") {
+		err = image->load_tga_from_buffer(buffer);
+	} else if (extension == "bmp") {
+		err = image->load_bmp_from_buffer(buffer);
+	} else if (extension == "ktx") {
+		err = image->load_ktx_from_buffer(buffer);
+	}
+
+	return err == OK ? image : nullptr;
+}
+
+static Ref<Image> load_image_from_archive(const UsdzArchive &archive, const std::string &asset_path) {
+	PackedByteArray buffer;
+
+	const uint8_t *data = nullptr;
+	size_t size = 0;
+	if (archive.get_stored_entry(asset_path, &data, &size)) {
+		buffer.resize(size);
+		memcpy(buffer.ptrw(), data, size);
+	} else {
+		std::vector<uint8_t> extracted;
+		std::string err;
+		ERR_FAIL_COND_V_MSG(!archive.extract_entry(asset_path, &extracted, &err), nullptr, err.c_str());
+		buffer.resize(extracted.size());
+		memcpy(buffer.ptrw(), extracted.data(), extracted.size());
+	}
+
+	return load_image_from_buffer(buffer, String(asset_path.c_str()).get_extension().to_lower());
+}
+
+Ref<UsdLoadedMaterials> extract_materials_impl(const tinyusdz::Stage &stage, const String &p_search_path, const UsdzArchive *p_archive) {
 	Ref<UsdLoadedMaterials> godot_material_map = nullptr;
 	tinyusdz::tydra::RenderSceneConverter converter;
 	tinyusdz::tydra::RenderSceneConverterEnv env(stage);
@@ -125,6 +168,13 @@ Ref<UsdLoadedMaterials> extract_materials_impl(const tinyusdz::Stage &stage, con
 	std::string custom_search_path = ProjectSettings::get_singleton()->globalize_path(p_search_path).utf8().get_data();
 	env.set_search_paths({ custom_search_path, project_search_path });
 
+	// Lets tydra resolve texture assets inside the package instead of searching the disk
+	tinyusdz::USDZAsset usdz_asset;
+	if (p_archive) {
+		p_archive->fill_usdz_asset(&usdz_asset);
+		tinyusdz::SetupUSDZAssetResolution(env.asset_resolver, &usdz_asset);
+	}
+
 	MaterialMap material_map;
 
 	ERR_FAIL_COND_V(!tinyusdz::tydra::ListPrims(stage, material_map), godot_material_map);
@@ -161,7 +211,9 @@ Ref<UsdLoadedMaterials> extract_materials_impl(const tinyusdz::Stage &stage, con
 
 		//image doesn't contain full path so check both project and custom search path
 		Ref<Image> godot_image = nullptr;
-		if (ResourceLoader::get_singleton()->exists(ProjectSettings::get_singleton()->localize_path(godot_image_file_path))) {
+		if (p_archive && p_archive->has_entry(image_file_path)) {
+			godot_image = load_image_from_archive(*p_archive, image_file_path);
+		} else if (ResourceLoader::get_singleton()->exists(ProjectSettings::get_singleton()->localize_path(godot_image_file_path))) {
 			godot_image_file_path = ProjectSettings::get_singleton()->localize_path(godot_image_file_path);
 			godot_image = godot::Image::load_from_file(godot_image_file_path);
 		} else if (ResourceLoader::get_singleton()->exists(ProjectSettings::get_singleton()->localize_path(p_search_path.path_join(godot_image_file_path)))) {
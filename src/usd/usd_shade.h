@@ -11,6 +11,7 @@
 #include "stage.hh"
 
 #include "usd/usd_common.h"
+#include "utils/usdz_archive.h"
 
 class UsdLoadedMaterials : public godot::RefCounted {
 	GDCLASS(UsdLoadedMaterials, godot::RefCounted);
@@ -49,4 +50,5 @@ public:
 	godot::String _to_string() const;
 };
 
-godot::Ref<UsdLoadedMaterials> extract_materials_impl(const tinyusdz::Stage &stage, const godot::String &p_search_path);
+/// p_archive is set for usdz packages, textures are then decoded straight from the archive
+godot::Ref<UsdLoadedMaterials> extract_materials_impl(const tinyusdz::Stage &stage, const godot::String &p_search_path, const UsdzArchive *p_archive = nullptr);
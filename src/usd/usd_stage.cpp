@@ -1,107 +1,561 @@
 #include "usd_stage.h"
+#include <godot_cpp/classes/file_access.hpp>
+#include <godot_cpp/classes/os.hpp>
 #include <godot_cpp/classes/project_settings.hpp>
+#include <godot_cpp/classes/worker_thread_pool.hpp>
+#include <godot_cpp/variant/callable_method_pointer.hpp>
+
+#include <atomic>
+#include <memory>
 
 #include "composition.hh"
 #include "godot_cpp/variant/utility_functions.hpp"
 #include "io-util.hh"
 #include "stream-reader.hh"
+#include "tinyusdz.hh"
+#include "usd_composition.h"
+#include "usd_stage_cache.h"
 #include "usda-reader.hh"
+#include "utils/io_utils.h"
+#include "utils/prim_index.h"
+#include "utils/thread_utils.h"
+#include "utils/usda_utils.h"
+#include "utils/usdz_archive.h"
 
 using namespace godot;
 
-tinyusdz::Stage *UsdStage::load_stage(const String &path) {
-	String global_path = ProjectSettings::get_singleton()->globalize_path(path);
-	std::string file_path = global_path.utf8().get_data();
+static void report_progress(const UsdStage::ProgressCallback &progress, float ratio) {
+	if (progress) {
+		progress(ratio);
+	}
+}
 
-	if (!tinyusdz::io::USDFileExists(file_path)) {
-		return nullptr;
+// Layers below this size parse fast enough on one thread that splitting them isn't worth it
+static constexpr size_t USDA_CHUNKED_MIN_SIZE = 8 * 1024 * 1024;
+
+static tinyusdz::Stage *read_usda_chunk(const UsdaChunk &chunk) {
+	// Only chunks made of several spans are copied, and only while they are parsed
+	std::string joined;
+	const char *text = chunk.spans.size() == 1 ? chunk.spans[0].data : nullptr;
+	size_t size = chunk.spans.size() == 1 ? chunk.spans[0].size : 0;
+	if (!text) {
+		joined = chunk.join();
+		text = joined.data();
+		size = joined.size();
 	}
 
-	if (!tinyusdz::IsUSDA(file_path)) {
+	tinyusdz::StreamReader sr(reinterpret_cast<const uint8_t *>(text), size, /* swap endian */ false);
+	tinyusdz::usda::USDAReader reader(&sr);
+
+	uint32_t load_states = static_cast<uint32_t>(tinyusdz::LoadState::Toplevel);
+	if (!reader.read(load_states, /* as_primspec */ false) || !reader.ReconstructStage()) {
+		WARN_PRINT(String("Failed to parse USDA chunk: ") + reader.GetError().c_str());
 		return nullptr;
 	}
 
-	std::vector<uint8_t> data;
-	std::string err;
-	if (!tinyusdz::io::ReadWholeFile(&data, &err, file_path, /* filesize_max */ 0)) {
+	return new tinyusdz::Stage(reader.get_stage());
+}
+
+/// Splits the layer at prim boundaries, parses the chunks on all cores and merges them back into one stage.
+/// Returns nullptr if the layer can't be split or a chunk fails, the caller then falls back to a single reader
+static tinyusdz::Stage *load_usda_stage_chunked(const uint8_t *data, size_t size, const UsdStage::ProgressCallback &progress) {
+	// More chunks than cores, so one large prim doesn't leave the other threads idle at the end
+	const size_t max_chunks = static_cast<size_t>(OS::get_singleton()->get_processor_count()) * 2;
+
+	UsdaChunks chunks;
+	if (!split_usda_layer(reinterpret_cast<const char *>(data), size, max_chunks, &chunks)) {
 		return nullptr;
 	}
 
-	tinyusdz::StreamReader sr(data.data(), data.size(), /* swap endian */ false);
+	const uint32_t chunk_count = static_cast<uint32_t>(chunks.chunks.size());
+	std::vector<std::unique_ptr<tinyusdz::Stage>> stages(chunk_count);
+	std::atomic<uint32_t> parsed_count(0);
+
+	parallel_for(chunk_count, [&](uint32_t chunk_idx) {
+		stages[chunk_idx].reset(read_usda_chunk(chunks.chunks[chunk_idx]));
+		const uint32_t parsed = ++parsed_count;
+		report_progress(progress, 0.1f + 0.7f * parsed / chunk_count);
+	}, "Parse USDA chunks");
+
+	for (const std::unique_ptr<tinyusdz::Stage> &stage : stages) {
+		if (!stage) {
+			return nullptr;
+		}
+	}
+
+	// Chunks are in file order, so appending keeps the original prim order
+	std::unique_ptr<tinyusdz::Stage> merged = std::move(stages[0]);
+	for (uint32_t chunk_idx = 1; chunk_idx < chunk_count; chunk_idx++) {
+		std::vector<tinyusdz::Prim> &chunk_roots = stages[chunk_idx]->root_prims();
+
+		if (chunks.split_root_children) {
+			ERR_FAIL_COND_V(chunk_roots.size() != 1 || merged->root_prims().size() != 1, nullptr);
+			std::vector<tinyusdz::Prim> &children = merged->root_prims()[0].children();
+			for (tinyusdz::Prim &child : chunk_roots[0].children()) {
+				children.push_back(std::move(child));
+			}
+		} else {
+			for (tinyusdz::Prim &prim : chunk_roots) {
+				merged->root_prims().push_back(std::move(prim));
+			}
+		}
+		stages[chunk_idx].reset();
+	}
+
+	// Recomputes absolute paths and prim ids for the moved prims
+	ERR_FAIL_COND_V_MSG(!merged->commit(), nullptr, "Failed to merge USDA chunks");
+	report_progress(progress, 0.9f);
+
+	return merged.release();
+}
+
+static tinyusdz::Stage *load_usda_stage(const uint8_t *data, size_t size, const UsdStage::ProgressCallback &progress) {
+	if (size >= USDA_CHUNKED_MIN_SIZE) {
+		tinyusdz::Stage *stage = load_usda_stage_chunked(data, size, progress);
+		if (stage) {
+			return stage;
+		}
+	}
+
+	tinyusdz::StreamReader sr(data, size, /* swap endian */ false);
 	tinyusdz::usda::USDAReader reader(&sr);
 
+	// Composition arcs are resolved on a separate layer in load_layer, this only reads the root layer
 	uint32_t load_states = static_cast<uint32_t>(tinyusdz::LoadState::Toplevel);
-	bool do_compose = false;
-	bool as_primspec = do_compose ? true : false;
-
-	if (!reader.read(load_states, as_primspec)) {
-		return nullptr;
+	if (!reader.read(load_states, /* as_primspec */ false)) {
+		ERR_FAIL_V_MSG(nullptr, String("Failed to parse USDA: ") + reader.GetError().c_str());
 	}
+	report_progress(progress, 0.8f);
 
 	if (!reader.ReconstructStage()) {
-		return nullptr;
+		ERR_FAIL_V_MSG(nullptr, String("Failed to reconstruct USDA stage: ") + reader.GetError().c_str());
 	}
 
-	auto stage = new tinyusdz::Stage(reader.get_stage());
-	return stage;
+	return new tinyusdz::Stage(reader.get_stage());
+}
+
+static std::shared_ptr<const PrimIndex> build_prim_index(const tinyusdz::Stage &stage) {
+	std::shared_ptr<PrimIndex> index = std::make_shared<PrimIndex>();
+	index->build(stage);
+	return index;
+}
+
+// Plain USDA layers take the (chunked) stage reader. Everything else is read once as a layer, which is composed if it has
+// composition arcs and converted to a stage as is otherwise
+static bool load_layer(const uint8_t *data, size_t size, const std::string &asset_name, const UsdzArchive *archive, const UsdStage::ProgressCallback &progress, UsdStageData *r_data) {
+	if (detect_usd_format(data, size) == UsdFileFormat::USDA && !usda_has_composition_arcs(reinterpret_cast<const char *>(data), size)) {
+		std::unique_ptr<tinyusdz::Stage> stage(load_usda_stage(data, size, progress));
+		if (!stage) {
+			return false;
+		}
+		r_data->stage = std::move(stage);
+		return true;
+	}
+
+	std::shared_ptr<tinyusdz::Layer> layer = std::make_shared<tinyusdz::Layer>();
+	std::string warn, err;
+	if (!tinyusdz::LoadLayerFromMemory(data, size, asset_name, layer.get(), &warn, &err)) {
+		ERR_FAIL_V_MSG(false, String("Failed to read USD layer: ") + err.c_str());
+	}
+	report_progress(progress, 0.8f);
+
+	if (!layer_has_composition_arcs(*layer)) {
+		std::shared_ptr<tinyusdz::Stage> stage = std::make_shared<tinyusdz::Stage>();
+		if (!tinyusdz::LayerToStage(*layer, stage.get(), &warn, &err)) {
+			ERR_FAIL_V_MSG(false, String("Failed to reconstruct USD stage: ") + err.c_str());
+		}
+		r_data->stage = stage;
+		return true;
+	}
+
+	std::shared_ptr<tinyusdz::Stage> composed = std::make_shared<tinyusdz::Stage>();
+	if (!compose_stage(*layer, r_data->base_dir, archive, {}, composed.get(), &r_data->payload_paths, &err, &r_data->asset_paths)) {
+		ERR_FAIL_V_MSG(false, String("Failed to compose USD stage: ") + err.c_str());
+	}
+	report_progress(progress, 0.9f);
+
+	r_data->stage = composed;
+	r_data->root_layer = layer;
+	return true;
+}
+
+static bool load_usdz_stage(const std::string &file_path, const UsdStage::ProgressCallback &progress, UsdStageData *r_data) {
+	std::shared_ptr<UsdzArchive> archive = std::make_shared<UsdzArchive>();
+	std::string err;
+	if (!archive->open(file_path, &err)) {
+		ERR_FAIL_V_MSG(false, String("Failed to open usdz package: ") + err.c_str());
+	}
+
+	const std::string &layer_name = archive->get_root_layer_name();
+
+	bool success = false;
+	const uint8_t *layer_data = nullptr;
+	size_t layer_size = 0;
+	if (archive->get_stored_entry(layer_name, &layer_data, &layer_size)) {
+		success = load_layer(layer_data, layer_size, layer_name, archive.get(), progress, r_data);
+	} else {
+		std::vector<uint8_t> extracted;
+		ERR_FAIL_COND_V_MSG(!archive->extract_entry(layer_name, &extracted, &err), false, err.c_str());
+		success = load_layer(extracted.data(), extracted.size(), layer_name, archive.get(), progress, r_data);
+	}
+
+	ERR_FAIL_COND_V_MSG(!success, false, String("Failed to load root layer of usdz package: ") + layer_name.c_str());
+
+	// Textures and payloads are read from the archive later on, so it has to stay mapped
+	r_data->archive = archive;
+	return true;
+}
+
+bool UsdStage::load_stage(const String &path, UsdStageData *r_data, const ProgressCallback &progress) {
+	String global_path = ProjectSettings::get_singleton()->globalize_path(path);
+	std::string file_path = global_path.utf8().get_data();
+
+	if (!tinyusdz::io::USDFileExists(file_path)) {
+		return false;
+	}
+
+	*r_data = UsdStageData();
+	r_data->base_dir = global_path.get_base_dir().utf8().get_data();
+
+	// The file stays mapped only while parsing, tinyusdz keeps its own copy of all values in the stage
+	MappedFile file;
+	std::string err;
+	if (!file.open(file_path, &err)) {
+		ERR_FAIL_V_MSG(false, String("Failed to read USD file: ") + err.c_str());
+	}
+	r_data->memory_size = file.size();
+	report_progress(progress, 0.1f);
+
+	bool success = false;
+	switch (detect_usd_format(file.data(), file.size())) {
+		case UsdFileFormat::USDA:
+		case UsdFileFormat::USDC:
+			success = load_layer(file.data(), file.size(), file_path, nullptr, progress, r_data);
+			break;
+		case UsdFileFormat::USDZ:
+			file.close();
+			success = load_usdz_stage(file_path, progress, r_data);
+			break;
+		default:
+			ERR_FAIL_V_MSG(false, "Unsupported USD file format: " + path);
+	}
+
+	if (success) {
+		r_data->prim_index = build_prim_index(*r_data->stage);
+		for (const std::string &asset_path : r_data->asset_paths) {
+			Ref<FileAccess> asset_file = FileAccess::open(String::utf8(asset_path.c_str()), FileAccess::READ);
+			if (asset_file.is_valid()) {
+				r_data->memory_size += asset_file->get_length();
+			}
+		}
+	}
+	return success;
 }
 
 Ref<UsdStage> UsdStage::create(std::shared_ptr<tinyusdz::Stage> stage) {
 	Ref<UsdStage> usd_stage;
 	usd_stage.instantiate();
-	usd_stage->_stage = stage;
+	usd_stage->_data.stage = stage;
+	if (stage) {
+		usd_stage->_data.prim_index = build_prim_index(*stage);
+	}
 	return usd_stage;
 }
 
+void UsdStage::clear_cache() {
+	UsdStageCache::get_singleton()->clear();
+}
+
+void UsdStage::set_cache_memory_budget(int64_t bytes) {
+	ERR_FAIL_COND(bytes < 0);
+	UsdStageCache::get_singleton()->set_memory_budget(static_cast<size_t>(bytes));
+}
+
+int64_t UsdStage::get_cache_memory_budget() {
+	return static_cast<int64_t>(UsdStageCache::get_singleton()->get_memory_budget());
+}
+
 void UsdStage::_bind_methods() {
+	ClassDB::bind_static_method("UsdStage", D_METHOD("clear_cache"), &UsdStage::clear_cache);
+	ClassDB::bind_static_method("UsdStage", D_METHOD("set_cache_memory_budget", "bytes"), &UsdStage::set_cache_memory_budget);
+	ClassDB::bind_static_method("UsdStage", D_METHOD("get_cache_memory_budget"), &UsdStage::get_cache_memory_budget);
+
 	ClassDB::bind_method(D_METHOD("load", "path"), &UsdStage::load);
+	ClassDB::bind_method(D_METHOD("load_async", "path"), &UsdStage::load_async);
+	ClassDB::bind_method(D_METHOD("is_loading"), &UsdStage::is_loading);
+	ClassDB::bind_method(D_METHOD("wait_for_load"), &UsdStage::wait_for_load);
 	ClassDB::bind_method(D_METHOD("is_valid"), &UsdStage::is_valid);
+	ClassDB::bind_method(D_METHOD("load_payload", "path"), &UsdStage::load_payload);
+	ClassDB::bind_method(D_METHOD("unload_payload", "path"), &UsdStage::unload_payload);
+	ClassDB::bind_method(D_METHOD("is_payload_loaded", "path"), &UsdStage::is_payload_loaded);
+	ClassDB::bind_method(D_METHOD("get_payload_paths"), &UsdStage::get_payload_paths);
+	ClassDB::bind_method(D_METHOD("load_all_payloads"), &UsdStage::load_all_payloads);
 	ClassDB::bind_method(D_METHOD("get_prim_at_path", "path"), &UsdStage::get_prim_at_path);
 	ClassDB::bind_method(D_METHOD("get_root_prims"), &UsdStage::get_root_prims);
+	ClassDB::bind_method(D_METHOD("traverse"), &UsdStage::traverse);
 	ClassDB::bind_method(D_METHOD("extract_materials"), &UsdStage::extract_materials);
 	ClassDB::bind_method(D_METHOD("get_up_axis"), &UsdStage::get_up_axis);
+	ClassDB::bind_method(D_METHOD("get_meters_per_unit"), &UsdStage::get_meters_per_unit);
+
+	ADD_SIGNAL(MethodInfo("loaded", PropertyInfo(Variant::BOOL, "success")));
+	ADD_SIGNAL(MethodInfo("progress", PropertyInfo(Variant::FLOAT, "ratio")));
 }
 
 bool UsdStage::load(const String &path) {
-	tinyusdz::Stage *stage = load_stage(path);
-	if (stage) {
-		_stage = std::shared_ptr<tinyusdz::Stage>(stage);
+	ERR_FAIL_COND_V_MSG(is_loading(), false, "Stage is already loading asynchronously");
+
+	UsdStageData data;
+	if (UsdStageCache::get_singleton()->load(path, &data)) {
+		_data = std::move(data);
+		_loaded_payloads.clear();
 		_loaded_path = path;
 		return true;
 	}
 	return false;
 }
 
+Error UsdStage::load_async(const String &path) {
+	ERR_FAIL_COND_V_MSG(is_loading(), ERR_BUSY, "Stage is already loading asynchronously");
+
+	// Stage stays invalid until the load finished
+	_data = UsdStageData();
+	_loaded_payloads.clear();
+	_loaded_path = "";
+
+	// Keeps the stage alive while the worker uses it, released again in _finish_load_async
+	_self_ref = Ref<UsdStage>(this);
+	_load_generation++;
+	_load_task_id = WorkerThreadPool::get_singleton()->add_task(callable_mp(this, &UsdStage::_load_task).bind(path, _load_generation), false, "Load USD stage " + path);
+	return OK;
+}
+
+bool UsdStage::is_loading() const {
+	return _load_task_id != -1;
+}
+
+bool UsdStage::wait_for_load() {
+	if (is_loading()) {
+		_finish_load_async(_load_generation);
+	}
+	return is_valid();
+}
+
+void UsdStage::_load_task(const String &path, uint64_t generation) {
+	UsdStageData data;
+	const bool success = UsdStageCache::get_singleton()->load(path, &data, [this, generation](float ratio) {
+		callable_mp(this, &UsdStage::_emit_load_progress).call_deferred(ratio, generation);
+	});
+
+	{
+		std::lock_guard<std::mutex> lock(_load_mutex);
+		_pending_data = std::move(data);
+		_pending_success = success;
+		_pending_path = path;
+	}
+
+	callable_mp(this, &UsdStage::_finish_load_async).call_deferred(generation);
+}
+
+void UsdStage::_emit_load_progress(float ratio, uint64_t generation) {
+	// Progress still queued when wait_for_load finished the load is dropped, so it never follows loaded
+	if (is_loading() && generation == _load_generation) {
+		emit_signal("progress", ratio);
+	}
+}
+
+void UsdStage::_finish_load_async(uint64_t generation) {
+	// Either called deferred or from wait_for_load, whichever comes first finishes the load.
+	// A deferred call of a load that wait_for_load already finished must not finish the next one
+	if (!is_loading() || generation != _load_generation) {
+		return;
+	}
+
+	WorkerThreadPool::get_singleton()->wait_for_task_completion(_load_task_id);
+	_load_task_id = -1;
+
+	{
+		std::lock_guard<std::mutex> lock(_load_mutex);
+		if (_pending_success) {
+			_data = std::move(_pending_data);
+			_loaded_path = _pending_path;
+		}
+		_pending_data = UsdStageData();
+		_pending_path = String();
+	}
+
+	const bool success = is_valid();
+	if (success) {
+		emit_signal("progress", 1.0f);
+	}
+	emit_signal("loaded", success);
+
+	// Might be the last reference, so this has to happen last
+	Ref<UsdStage> self_ref = _self_ref;
+	_self_ref.unref();
+}
+
+bool UsdStage::_recompose() {
+	if (!_data.root_layer) {
+		return true;
+	}
+
+	std::shared_ptr<tinyusdz::Stage> stage = std::make_shared<tinyusdz::Stage>();
+	std::set<std::string> payload_paths;
+	std::string err;
+	if (!compose_stage(*_data.root_layer, _data.base_dir, _data.archive.get(), _loaded_payloads, stage.get(), &payload_paths, &err)) {
+		ERR_FAIL_V_MSG(false, String("Failed to compose USD stage: ") + err.c_str());
+	}
+
+	_data.stage = stage;
+	_data.prim_index = build_prim_index(*stage);
+	_data.payload_paths = std::move(payload_paths);
+	return true;
+}
+
+bool UsdStage::load_payload(Ref<UsdPath> path) {
+	ERR_FAIL_COND_V(!is_valid() || path.is_null(), false);
+
+	const std::string prim_path = path->prim_path().utf8().get_data();
+	ERR_FAIL_COND_V_MSG(_data.payload_paths.find(prim_path) == _data.payload_paths.end(), false, "Prim has no payload: " + path->prim_path());
+
+	if (!_loaded_payloads.insert(prim_path).second) {
+		return true;
+	}
+	return _recompose();
+}
+
+bool UsdStage::unload_payload(Ref<UsdPath> path) {
+	ERR_FAIL_COND_V(!is_valid() || path.is_null(), false);
+
+	const std::string prim_path = path->prim_path().utf8().get_data();
+	if (_loaded_payloads.erase(prim_path) == 0) {
+		return true;
+	}
+
+	// Nested payloads came with the unloaded one, so they go away as well
+	const std::string prefix = prim_path + "/";
+	for (auto it = _loaded_payloads.begin(); it != _loaded_payloads.end();) {
+		if (it->compare(0, prefix.size(), prefix) == 0) {
+			it = _loaded_payloads.erase(it);
+		} else {
+			++it;
+		}
+	}
+
+	return _recompose();
+}
+
+bool UsdStage::is_payload_loaded(Ref<UsdPath> path) const {
+	ERR_FAIL_COND_V(path.is_null(), false);
+	return _loaded_payloads.find(path->prim_path().utf8().get_data()) != _loaded_payloads.end();
+}
+
+TypedArray<UsdPath> UsdStage::get_payload_paths() const {
+	TypedArray<UsdPath> paths;
+	for (const std::string &path : _data.payload_paths) {
+		paths.push_back(UsdPath::from_string(String::utf8(path.c_str())));
+	}
+	return paths;
+}
+
+bool UsdStage::load_all_payloads() {
+	ERR_FAIL_COND_V(!is_valid(), false);
+
+	// Loaded payloads can contain payloads themselves, the set of paths only grows so this terminates
+	while (_loaded_payloads.size() < _data.payload_paths.size()) {
+		const size_t loaded_count = _loaded_payloads.size();
+		_loaded_payloads.insert(_data.payload_paths.begin(), _data.payload_paths.end());
+		if (_loaded_payloads.size() == loaded_count) {
+			break;
+		}
+		if (!_recompose()) {
+			return false;
+		}
+	}
+	return true;
+}
+
 Ref<UsdPrim> UsdStage::get_prim_at_path(Ref<UsdPath> path) const {
 	if (!is_valid() || path.is_null() || !path->is_valid()) {
 		return Ref<UsdPrim>();
 	}
 
-	return UsdPrim::create(_stage, path->get_path());
+	// Unknown paths still return a prim, it's just invalid
+	return UsdPrim::create(_data.stage, path->get_path(), _data.prim_index->find(path->get_path()));
 }
 
 TypedArray<UsdPrim> UsdStage::get_root_prims() const {
 	TypedArray<UsdPrim> root_prims;
 	ERR_FAIL_COND_V(!is_valid(), root_prims);
 
-	const auto &prims = _stage->root_prims();
+	const auto &prims = _data.stage->root_prims();
 	for (const auto &prim : prims) {
-		root_prims.push_back(UsdPrim::create(_stage, prim.absolute_path()));
+		root_prims.push_back(UsdPrim::create(_data.stage, &prim));
 	}
 
 	return root_prims;
 }
 
+Dictionary UsdStage::traverse() const {
+	Dictionary result;
+	ERR_FAIL_COND_V(!is_valid(), result);
+
+	// Breadth-first, so the children of every prim end up next to each other
+	std::vector<const tinyusdz::Prim *> prims;
+	std::vector<int32_t> parents;
+	prims.reserve(_data.prim_index->size());
+	parents.reserve(_data.prim_index->size());
+	for (const tinyusdz::Prim &prim : _data.stage->root_prims()) {
+		prims.push_back(&prim);
+		parents.push_back(-1);
+	}
+
+	PackedInt32Array child_start;
+	PackedInt32Array child_count;
+	for (size_t i = 0; i < prims.size(); i++) {
+		const std::vector<tinyusdz::Prim> &children = prims[i]->children();
+		child_start.push_back(static_cast<int32_t>(prims.size()));
+		child_count.push_back(static_cast<int32_t>(children.size()));
+		for (const tinyusdz::Prim &child : children) {
+			prims.push_back(&child);
+			parents.push_back(static_cast<int32_t>(i));
+		}
+	}
+
+	const int64_t count = static_cast<int64_t>(prims.size());
+	PackedStringArray paths;
+	PackedInt32Array parent_indices;
+	PackedInt32Array types;
+	paths.resize(count);
+	parent_indices.resize(count);
+	types.resize(count);
+
+	int32_t *parents_ptr = parent_indices.ptrw();
+	int32_t *types_ptr = types.ptrw();
+	for (int64_t i = 0; i < count; i++) {
+		paths.set(i, String::utf8(prims[i]->absolute_path().prim_part().c_str()));
+		parents_ptr[i] = parents[i];
+		types_ptr[i] = UsdPrim::get_prim_type(prims[i]);
+	}
+
+	result["paths"] = paths;
+	result["parents"] = parent_indices;
+	result["types"] = types;
+	result["child_start"] = child_start;
+	result["child_count"] = child_count;
+	return result;
+}
+
 bool UsdStage::is_valid() const {
-	return _stage != nullptr;
+	return _data.stage != nullptr;
 }
 
 Ref<UsdLoadedMaterials> UsdStage::extract_materials() const {
-	return extract_materials_impl(*_stage, _loaded_path.get_base_dir());
+	return extract_materials_impl(*_data.stage, _loaded_path.get_base_dir(), _data.archive.get());
 }
 
 Vector3::Axis UsdStage::get_up_axis() const {
-	switch (_stage->metas().upAxis.get_value()) {
+	switch (_data.stage->metas().upAxis.get_value()) {
 		case tinyusdz::Axis::Y:
 			return Vector3::AXIS_Y;
 		case tinyusdz::Axis::Z:
@@ -111,6 +565,9 @@ Vector3::Axis UsdStage::get_up_axis() const {
 	}
 }
 
-UsdStage::UsdStage() :
-		_stage(nullptr) {
+double UsdStage::get_meters_per_unit() const {
+	return _data.stage->metas().metersPerUnit.get_value();
+}
+
+UsdStage::UsdStage() {
 }
@@ -3,41 +3,116 @@
 #include <godot_cpp/classes/ref_counted.hpp>
 #include <godot_cpp/core/class_db.hpp>
 
+#include <godot_cpp/variant/dictionary.hpp>
 #include <godot_cpp/variant/typed_array.hpp>
 
+#include <functional>
+#include <mutex>
+#include <set>
+
 #include "usd_common.h"
 #include "usd_prim.h"
 #include "usd_shade.h"
+#include "utils/prim_index.h"
+#include "utils/usdz_archive.h"
+
+/// Everything loading a stage file produces
+struct UsdStageData {
+	std::shared_ptr<tinyusdz::Stage> stage;
+	/// Built once per stage and shared along with it, resolves paths without walking the hierarchy
+	std::shared_ptr<const PrimIndex> prim_index;
+	/// Only set for usdz packages, keeps the archive mapped for texture decoding
+	std::shared_ptr<UsdzArchive> archive;
+	/// Only set if the stage has composition arcs, kept so payloads can be recomposed later
+	std::shared_ptr<const tinyusdz::Layer> root_layer;
+	std::string base_dir;
+	/// Paths of all composed prims that have a payload, loaded or not
+	std::set<std::string> payload_paths;
+	/// Files composed into the stage besides the source file, the stage cache reloads the stage if any of them changes
+	std::set<std::string> asset_paths;
+	/// Size of the source file and all asset_paths. The stage cache budget is on this, the parsed stage takes a multiple of it
+	size_t memory_size = 0;
+};
 
 /// Represents a USD stage
-/// Once loaded can't change values so this is a read-only object
+/// Once loaded can't change values so this is a read-only object.
+/// Loading or unloading payloads recomposes the stage, prims got before that keep the old stage
 class UsdStage : public godot::RefCounted {
 	GDCLASS(UsdStage, RefCounted);
 
 private:
-	std::shared_ptr<tinyusdz::Stage> _stage;
+	UsdStageData _data;
+	std::set<std::string> _loaded_payloads;
 	godot::String _loaded_path = "";
 
+	// async loading, the worker only writes the pending values and the main thread picks them up
+	int64_t _load_task_id = -1;
+	// Tells the progress of the running load apart from progress a finished one still has queued
+	uint64_t _load_generation = 0;
+	godot::Ref<UsdStage> _self_ref;
+	std::mutex _load_mutex;
+	UsdStageData _pending_data;
+	bool _pending_success = false;
+	godot::String _pending_path;
+
+	void _load_task(const godot::String &path, uint64_t generation);
+	void _emit_load_progress(float ratio, uint64_t generation);
+	void _finish_load_async(uint64_t generation);
+	bool _recompose();
+
 protected:
 	static void _bind_methods();
 
 public:
-	static tinyusdz::Stage *load_stage(const godot::String &path);
+	/// Called with the load progress in [0, 1]. Might be called from a worker thread
+	using ProgressCallback = std::function<void(float)>;
+
+	/// Loads and, if needed, composes the stage at path. Payloads are left unloaded.
+	/// Bypasses the stage cache, use UsdStageCache::load to share stages
+	static bool load_stage(const godot::String &path, UsdStageData *r_data, const ProgressCallback &progress = nullptr);
 	static godot::Ref<UsdStage> create(std::shared_ptr<tinyusdz::Stage> stage);
 
+	/// Drops all cached stages, the next load of every file parses it again
+	static void clear_cache();
+	/// Budget on the summed file size of the cached stages, not on the memory their parsed stages take
+	static void set_cache_memory_budget(int64_t bytes);
+	static int64_t get_cache_memory_budget();
+
 	bool load(const godot::String &path);
+	/// Parses the stage on the WorkerThreadPool. Emits progress while loading and loaded once done,
+	/// the stage is invalid until then. No progress is emitted after loaded
+	godot::Error load_async(const godot::String &path);
+	bool is_loading() const;
+	/// Blocks until a running async load finished. Returns is_valid()
+	bool wait_for_load();
 	bool is_valid() const;
 
+	/// Composes the payload of the prim at path into the stage
+	bool load_payload(godot::Ref<UsdPath> path);
+	bool unload_payload(godot::Ref<UsdPath> path);
+	bool is_payload_loaded(godot::Ref<UsdPath> path) const;
+	/// Returns the paths of all prims with a payload, including nested ones of loaded payloads
+	godot::TypedArray<UsdPath> get_payload_paths() const;
+	/// Loads payloads until there are no unloaded ones left
+	bool load_all_payloads();
+
 	godot::Ref<UsdPrim> get_prim_at_path(godot::Ref<UsdPath> path) const;
 
 	godot::TypedArray<UsdPrim> get_root_prims() const;
 
+	/// Returns the whole prim hierarchy in breadth-first order as packed arrays, without creating a UsdPrim per prim.
+	/// The dictionary has "paths" (PackedStringArray), "parents" (-1 for root prims), "types" (UsdPrimType.Type),
+	/// "child_start" and "child_count" (PackedInt32Array). Children of a prim are the range [child_start, child_start + child_count)
+	godot::Dictionary traverse() const;
+
 	void set_loaded_path(const godot::String &path) { _loaded_path = path; }
 	godot::String get_loaded_path() const { return _loaded_path; }
 
 	godot::Ref<UsdLoadedMaterials> extract_materials() const;
 
 	godot::Vector3::Axis get_up_axis() const;
+	/// Stage metersPerUnit, e.g. 0.01 for a stage in centimeters
+	double get_meters_per_unit() const;
 
 	UsdStage();
 };
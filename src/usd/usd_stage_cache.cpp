@@ -0,0 +1,105 @@
+#include "usd_stage_cache.h"
+
+#include <godot_cpp/classes/file_access.hpp>
+#include <godot_cpp/classes/project_settings.hpp>
+
+using namespace godot;
+
+static constexpr size_t DEFAULT_MEMORY_BUDGET = 1024 * 1024 * 1024;
+
+UsdStageCache *UsdStageCache::get_singleton() {
+	static UsdStageCache singleton;
+	return &singleton;
+}
+
+bool UsdStageCache::load(const String &path, UsdStageData *r_data, const UsdStage::ProgressCallback &progress) {
+	const String global_path = ProjectSettings::get_singleton()->globalize_path(path);
+	const std::string key = global_path.utf8().get_data();
+	const uint64_t modified_time = FileAccess::get_modified_time(global_path);
+
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		auto found = _index.find(key);
+		if (found != _index.end()) {
+			if (found->second->modified_time == modified_time && found->second->asset_modified_times == _get_asset_modified_times(found->second->data)) {
+				_entries.splice(_entries.begin(), _entries, found->second);
+				*r_data = found->second->data;
+				return true;
+			}
+			_erase(found->second);
+		}
+	}
+
+	// Parsing happens outside the lock, two threads loading the same file both parse it and the last one is cached
+	UsdStageData data;
+	if (!UsdStage::load_stage(path, &data, progress)) {
+		return false;
+	}
+	*r_data = data;
+
+	std::lock_guard<std::mutex> lock(_mutex);
+	if (data.memory_size > _memory_budget) {
+		return true;
+	}
+
+	auto found = _index.find(key);
+	if (found != _index.end()) {
+		_erase(found->second);
+	}
+
+	std::vector<uint64_t> asset_modified_times = _get_asset_modified_times(data);
+	_entries.push_front(Entry{ key, modified_time, std::move(asset_modified_times), std::move(data) });
+	_index[key] = _entries.begin();
+	_memory_size += _entries.front().data.memory_size;
+	_evict();
+	return true;
+}
+
+std::vector<uint64_t> UsdStageCache::_get_asset_modified_times(const UsdStageData &data) {
+	std::vector<uint64_t> modified_times;
+	modified_times.reserve(data.asset_paths.size());
+	for (const std::string &asset_path : data.asset_paths) {
+		modified_times.push_back(FileAccess::get_modified_time(String::utf8(asset_path.c_str())));
+	}
+	return modified_times;
+}
+
+void UsdStageCache::_erase(std::list<Entry>::iterator it) {
+	_memory_size -= it->data.memory_size;
+	_index.erase(it->path);
+	_entries.erase(it);
+}
+
+void UsdStageCache::_evict() {
+	// Evicted stages stay alive as long as a UsdStage still uses them
+	while (_memory_size > _memory_budget && !_entries.empty()) {
+		_erase(std::prev(_entries.end()));
+	}
+}
+
+void UsdStageCache::clear() {
+	std::lock_guard<std::mutex> lock(_mutex);
+	_entries.clear();
+	_index.clear();
+	_memory_size = 0;
+}
+
+void UsdStageCache::set_memory_budget(size_t bytes) {
+	std::lock_guard<std::mutex> lock(_mutex);
+	_memory_budget = bytes;
+	_evict();
+}
+
+size_t UsdStageCache::get_memory_budget() {
+	std::lock_guard<std::mutex> lock(_mutex);
+	return _memory_budget;
+}
+
+size_t UsdStageCache::get_memory_size() {
+	std::lock_guard<std::mutex> lock(_mutex);
+	return _memory_size;
+}
+
+UsdStageCache::UsdStageCache() :
+		_memory_budget(DEFAULT_MEMORY_BUDGET) {
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "usd_stage.h"
+
+/// Shares loaded stages between all UsdStage instances that load the same file.
+/// Entries are keyed by globalized path and invalidated when the modification time of the file or of any layer composed into
+/// it changes, least recently used entries are dropped once the cached stages exceed the budget on their file sizes
+class UsdStageCache {
+private:
+	struct Entry {
+		std::string path;
+		uint64_t modified_time = 0;
+		/// Modification times of data.asset_paths, in the same order
+		std::vector<uint64_t> asset_modified_times;
+		UsdStageData data;
+	};
+
+	/// Most recently used first
+	std::list<Entry> _entries;
+	std::unordered_map<std::string, std::list<Entry>::iterator> _index;
+	size_t _memory_size = 0;
+	size_t _memory_budget;
+	std::mutex _mutex;
+
+	static std::vector<uint64_t> _get_asset_modified_times(const UsdStageData &data);
+	void _erase(std::list<Entry>::iterator it);
+	void _evict();
+
+public:
+	static UsdStageCache *get_singleton();
+
+	/// Same as UsdStage::load_stage, but returns the cached stage if the file didn't change since it was loaded
+	bool load(const godot::String &path, UsdStageData *r_data, const UsdStage::ProgressCallback &progress = nullptr);
+	void clear();
+
+	void set_memory_budget(size_t bytes);
+	size_t get_memory_budget();
+	size_t get_memory_size();
+
+	UsdStageCache();
+};
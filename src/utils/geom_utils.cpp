@@ -3,14 +3,137 @@
 #include "godot_cpp/core/math.hpp"
 #include "godot_cpp/variant/array.hpp"
 #include "godot_cpp/variant/string.hpp"
+#include <algorithm>
+#include <array>
 #include <cmath>
+#include <cstring>
 #include <limits>
+#include <vector>
 
 #include "external/mapbox/earcut/earcut.hpp"
 #include "godot_cpp/variant/variant.hpp"
+#include "utils/thread_utils.h"
 
 using namespace godot;
 
+// Points per range when transforming in parallel, ranges this small are still only a few microseconds of work
+static constexpr int64_t TRANSFORM_RANGE_SIZE = 65536;
+
+// Faces per range when triangulating in parallel, and the face count above which that is worth it
+static constexpr int64_t TRIANGULATE_PARALLEL_MIN_FACES = 100000;
+static constexpr int64_t TRIANGULATE_RANGE_SIZE = 16384;
+
+using Point2D = std::array<real_t, 2>;
+
+// Earcut keeps its node pool and the polygon buffer between calls, so every worker thread reuses its own
+struct EarcutScratch {
+	mapbox::detail::Earcut<uint32_t> earcut;
+	std::vector<std::vector<Point2D>> polygon_2d = std::vector<std::vector<Point2D>>(1);
+};
+
+static thread_local EarcutScratch earcut_scratch;
+
+// Writes the triangles of one face to r_indices and r_map, returns how many were written or -1 on error.
+// There is room for npolys - 2 triangles, earcut can return less than that for degenerate polygons
+static int64_t triangulate_face(
+		const Vector3 *points,
+		int64_t point_count,
+		const int32_t *face_indices,
+		int32_t npolys,
+		int64_t face_index_offset,
+		int32_t *r_indices,
+		int64_t *r_map,
+		String &error) {
+	if (npolys == 3) {
+		// No need for triangulation.
+		for (int k = 0; k < 3; k++) {
+			r_indices[k] = face_indices[k];
+			r_map[k] = face_index_offset + k;
+		}
+		return 1;
+	}
+
+	if (npolys == 4) {
+		// Use simple split
+		// TODO: Split at shortest edge for better triangulation.
+		static const int quad_corners[6] = { 0, 1, 2, 0, 2, 3 };
+		for (int k = 0; k < 6; k++) {
+			r_indices[k] = face_indices[quad_corners[k]];
+			r_map[k] = face_index_offset + quad_corners[k];
+		}
+		return 2;
+	}
+
+	// Use double for accuracy. `float` precision may classify small-area polygon as degenerated.
+	// Find the normal axis of the polygon using Newell's method
+	Vector3 n(0, 0, 0);
+
+	for (int k = 0; k < npolys; ++k) {
+		int vi0 = face_indices[k];
+		int vi0_2 = face_indices[(k + 1) % npolys];
+
+		if (vi0 < 0 || vi0 >= point_count || vi0_2 < 0 || vi0_2 >= point_count) {
+			error = "Invalid vertex index.";
+			return -1;
+		}
+
+		const Vector3 &point1 = points[vi0];
+		const Vector3 &point2 = points[vi0_2];
+
+		Vector3 a(point1.x - point2.x, point1.y - point2.y, point1.z - point2.z);
+		Vector3 b(point1.x + point2.x, point1.y + point2.y, point1.z + point2.z);
+
+		n.x += a.y * b.z;
+		n.y += a.z * b.x;
+		n.z += a.x * b.y;
+	}
+
+	real_t length_n = n.length();
+
+	// Check if zero length normal
+	if (Math::abs(length_n) < std::numeric_limits<double>::epsilon()) {
+		error = "Degenerated polygon found.";
+		return -1;
+	}
+
+	// Normalize the normal vector
+	Vector3 axis_w = n / length_n;
+
+	Vector3 a;
+	if (Math::abs(axis_w.x) > 0.9999999) {
+		a = Vector3(0, 1, 0);
+	} else {
+		a = Vector3(1, 0, 0);
+	}
+
+	Vector3 axis_v = a.cross(axis_w).normalized();
+	Vector3 axis_u = axis_w.cross(axis_v);
+
+	// Fill polygon data, world to local
+	std::vector<Point2D> &polyline = earcut_scratch.polygon_2d[0];
+	polyline.resize(npolys);
+	for (int k = 0; k < npolys; k++) {
+		const Vector3 &v = points[face_indices[k]];
+		polyline[k] = { v.dot(axis_u), v.dot(axis_v) };
+	}
+
+	earcut_scratch.earcut(earcut_scratch.polygon_2d);
+	const std::vector<uint32_t> &indices = earcut_scratch.earcut.indices;
+	//  => result = 3 * faces, clockwise
+
+	if ((indices.size() % 3) != 0 || indices.size() > size_t(npolys - 2) * 3) {
+		// This should not happen, though.
+		error = "Failed to triangulate.";
+		return -1;
+	}
+
+	for (size_t k = 0; k < indices.size(); k++) {
+		r_indices[k] = face_indices[indices[k]];
+		r_map[k] = face_index_offset + indices[k];
+	}
+	return indices.size() / 3;
+}
+
 bool triangulate_polygon(
 		const PackedVector3Array &points,
 		const PackedInt32Array &face_vertex_counts,
@@ -19,171 +142,115 @@ bool triangulate_polygon(
 		PackedInt32Array &triangulated_face_vertex_indices,
 		PackedInt64Array &triangulated_to_orig_face_vertex_index_map,
 		PackedInt32Array &triangulated_face_counts, String &error) {
-	triangulated_face_vertex_counts.clear();
-	triangulated_face_vertex_indices.clear();
-	triangulated_to_orig_face_vertex_index_map.clear();
-	triangulated_face_counts.clear();
+	const int64_t face_count = face_vertex_counts.size();
+	const int32_t *counts_ptr = face_vertex_counts.ptr();
 
-	size_t face_index_offset = 0;
+	// First pass validates the faces and sizes all outputs, so the second pass only writes into preallocated memory
+	std::vector<int64_t> face_index_offsets(face_count + 1);
+	std::vector<int64_t> tri_offsets(face_count + 1);
+	face_index_offsets[0] = 0;
+	tri_offsets[0] = 0;
+	bool all_triangles = true;
 
-	// For each polygon(face)
-	for (int i = 0; i < face_vertex_counts.size(); i++) {
-		int npolys = face_vertex_counts[i];
+	for (int64_t i = 0; i < face_count; i++) {
+		int npolys = counts_ptr[i];
 
 		if (npolys < 3) {
 			error = String("faceVertex count must be 3(triangle) or more(polygon), but got faceVertexCounts[{0}] = {1}").format(Array::make(i, npolys));
 			return false;
 		}
 
-		if (face_index_offset + npolys > face_vertex_indices.size()) {
+		if (face_index_offsets[i] + npolys > face_vertex_indices.size()) {
 			error = String("Invalid faceVertexIndices or faceVertexCounts. faceVertex index exceeds faceVertexIndices.size() at [{0}]").format(Array::make(i));
 			return false;
 		}
 
-		if (npolys == 3) {
-			// No need for triangulation.
-			triangulated_face_vertex_counts.push_back(3);
-			triangulated_face_vertex_indices.push_back(face_vertex_indices[face_index_offset + 0]);
-			triangulated_face_vertex_indices.push_back(face_vertex_indices[face_index_offset + 1]);
-			triangulated_face_vertex_indices.push_back(face_vertex_indices[face_index_offset + 2]);
-			triangulated_to_orig_face_vertex_index_map.push_back(face_index_offset + 0);
-			triangulated_to_orig_face_vertex_index_map.push_back(face_index_offset + 1);
-			triangulated_to_orig_face_vertex_index_map.push_back(face_index_offset + 2);
-			triangulated_face_counts.push_back(1);
-		} else if (npolys == 4) {
-			// Use simple split
-			// TODO: Split at shortest edge for better triangulation.
-			triangulated_face_vertex_counts.push_back(3);
-			triangulated_face_vertex_counts.push_back(3);
-
-			triangulated_face_vertex_indices.push_back(face_vertex_indices[face_index_offset + 0]);
-			triangulated_face_vertex_indices.push_back(face_vertex_indices[face_index_offset + 1]);
-			triangulated_face_vertex_indices.push_back(face_vertex_indices[face_index_offset + 2]);
-
-			triangulated_face_vertex_indices.push_back(face_vertex_indices[face_index_offset + 0]);
-			triangulated_face_vertex_indices.push_back(face_vertex_indices[face_index_offset + 2]);
-			triangulated_face_vertex_indices.push_back(face_vertex_indices[face_index_offset + 3]);
-
-			triangulated_to_orig_face_vertex_index_map.push_back(face_index_offset + 0);
-			triangulated_to_orig_face_vertex_index_map.push_back(face_index_offset + 1);
-			triangulated_to_orig_face_vertex_index_map.push_back(face_index_offset + 2);
-			triangulated_to_orig_face_vertex_index_map.push_back(face_index_offset + 0);
-			triangulated_to_orig_face_vertex_index_map.push_back(face_index_offset + 2);
-			triangulated_to_orig_face_vertex_index_map.push_back(face_index_offset + 3);
-			triangulated_face_counts.push_back(2);
-		} else {
-			// Use double for accuracy. `float` precision may classify small-area polygon as degenerated.
-			// Find the normal axis of the polygon using Newell's method
-			Vector3 n(0, 0, 0);
-
-			int vi0, vi0_2;
-
-			for (int k = 0; k < npolys; ++k) {
-				vi0 = face_vertex_indices[face_index_offset + k];
-
-				int j = (k + 1) % npolys;
-				vi0_2 = face_vertex_indices[face_index_offset + j];
-
-				if (vi0 >= points.size()) {
-					error = "Invalid vertex index.";
-					return false;
-				}
-
-				if (vi0_2 >= points.size()) {
-					error = "Invalid vertex index.";
-					return false;
-				}
-
-				Vector3 v0 = points[vi0];
-				Vector3 v1 = points[vi0_2];
-
-				Vector3 point1(v0.x, v0.y, v0.z);
-				Vector3 point2(v1.x, v1.y, v1.z);
-
-				Vector3 a(point1.x - point2.x, point1.y - point2.y, point1.z - point2.z);
-				Vector3 b(point1.x + point2.x, point1.y + point2.y, point1.z + point2.z);
-
-				n.x += a.y * b.z;
-				n.y += a.z * b.x;
-				n.z += a.x * b.y;
-			}
-
-			real_t length_n = n.length();
-
-			// Check if zero length normal
-			if (Math::abs(length_n) < std::numeric_limits<double>::epsilon()) {
-				error = "Degenerated polygon found.";
-				return false;
-			}
-
-			// Normalize the normal vector
-			n = n.normalized();
-
-			Vector3 axis_w, axis_v, axis_u;
-			axis_w.x = n.x;
-			axis_w.y = n.y;
-			axis_w.z = n.z;
-
-			Vector3 a;
-			if (Math::abs(axis_w.x) > 0.9999999) {
-				a = Vector3(0, 1, 0);
-			} else {
-				a = Vector3(1, 0, 0);
-			}
-
-			axis_v = a.cross(axis_w).normalized();
-			axis_u = axis_w.cross(axis_v);
-
-			using Point2D = std::array<real_t, 2>;
-			std::vector<Point2D> polyline;
-
-			// Fill polygon data
-			for (int k = 0; k < npolys; k++) {
-				int vidx = face_vertex_indices[face_index_offset + k];
-
-				Vector3 v = points[vidx];
-
-				// world to local
-				real_t x = v.dot(axis_u);
-				real_t y = v.dot(axis_v);
-
-				polyline.push_back({ x, y });
-			}
-
-			std::vector<std::vector<Point2D>> polygon_2d;
-			polygon_2d.push_back(polyline);
-
-			std::vector<uint32_t> indices = mapbox::earcut<uint32_t>(polygon_2d);
-			//  => result = 3 * faces, clockwise
+		all_triangles = all_triangles && npolys == 3;
+		face_index_offsets[i + 1] = face_index_offsets[i] + npolys;
+		tri_offsets[i + 1] = tri_offsets[i] + npolys - 2;
+	}
 
-			if ((indices.size() % 3) != 0) {
-				// This should not happen, though.
-				error = "Failed to triangulate.";
-				return false;
-			}
+	// Up to 2GB tris.
+	const int64_t max_tris = tri_offsets[face_count];
+	if (max_tris > int64_t((std::numeric_limits<int32_t>::max)())) {
+		error = "Too many triangles are generated.";
+		return false;
+	}
 
-			size_t ntris = indices.size() / 3;
+	triangulated_face_vertex_counts.resize(max_tris);
+	triangulated_face_vertex_counts.fill(3);
+	triangulated_face_counts.resize(face_count);
+
+	if (all_triangles) {
+		// Already triangulated, the indices are shared instead of copied
+		const int64_t corner_count = max_tris * 3;
+		triangulated_face_vertex_indices = face_vertex_indices;
+		triangulated_face_vertex_indices.resize(corner_count);
+		triangulated_to_orig_face_vertex_index_map.resize(corner_count);
+		int64_t *map_ptr = triangulated_to_orig_face_vertex_index_map.ptrw();
+		for (int64_t i = 0; i < corner_count; i++) {
+			map_ptr[i] = i;
+		}
+		triangulated_face_counts.fill(1);
+		return true;
+	}
 
-			// Up to 2GB tris.
-			if (ntris > size_t((std::numeric_limits<int32_t>::max)())) {
-				error = "Too many triangles are generated.";
-				return false;
+	triangulated_face_vertex_indices.resize(max_tris * 3);
+	triangulated_to_orig_face_vertex_index_map.resize(max_tris * 3);
+
+	const Vector3 *points_ptr = points.ptr();
+	const int32_t *indices_ptr = face_vertex_indices.ptr();
+	int32_t *out_indices = triangulated_face_vertex_indices.ptrw();
+	int64_t *out_map = triangulated_to_orig_face_vertex_index_map.ptrw();
+	int32_t *out_face_counts = triangulated_face_counts.ptrw();
+
+	const uint32_t range_count = face_count >= TRIANGULATE_PARALLEL_MIN_FACES ? uint32_t((face_count + TRIANGULATE_RANGE_SIZE - 1) / TRIANGULATE_RANGE_SIZE) : 1;
+	const int64_t range_size = range_count > 1 ? TRIANGULATE_RANGE_SIZE : face_count;
+	std::vector<String> range_errors(range_count);
+
+	parallel_for(range_count, [&](uint32_t range_idx) {
+		const int64_t begin = range_idx * range_size;
+		const int64_t end = std::min(begin + range_size, face_count);
+
+		for (int64_t i = begin; i < end; i++) {
+			const int64_t written = triangulate_face(
+					points_ptr,
+					points.size(),
+					indices_ptr + face_index_offsets[i],
+					counts_ptr[i],
+					face_index_offsets[i],
+					out_indices + tri_offsets[i] * 3,
+					out_map + tri_offsets[i] * 3,
+					range_errors[range_idx]);
+
+			if (written < 0) {
+				return;
 			}
+			out_face_counts[i] = int32_t(written);
+		}
+	}, "Triangulate USD mesh");
 
-			for (size_t k = 0; k < ntris; k++) {
-				triangulated_face_vertex_counts.push_back(3);
-				triangulated_face_vertex_indices.push_back(face_vertex_indices[face_index_offset + indices[3 * k + 0]]);
-				triangulated_face_vertex_indices.push_back(face_vertex_indices[face_index_offset + indices[3 * k + 1]]);
-				triangulated_face_vertex_indices.push_back(face_vertex_indices[face_index_offset + indices[3 * k + 2]]);
+	for (const String &range_error : range_errors) {
+		if (!range_error.is_empty()) {
+			error = range_error;
+			return false;
+		}
+	}
 
-				triangulated_to_orig_face_vertex_index_map.push_back(face_index_offset + indices[3 * k + 0]);
-				triangulated_to_orig_face_vertex_index_map.push_back(face_index_offset + indices[3 * k + 1]);
-				triangulated_to_orig_face_vertex_index_map.push_back(face_index_offset + indices[3 * k + 2]);
-			}
-			triangulated_face_counts.push_back(ntris);
+	// Earcut returned fewer triangles than reserved for some faces, so close the gaps
+	int64_t tri_count = 0;
+	for (int64_t i = 0; i < face_count; i++) {
+		if (tri_count != tri_offsets[i]) {
+			std::memmove(out_indices + tri_count * 3, out_indices + tri_offsets[i] * 3, out_face_counts[i] * 3 * sizeof(int32_t));
+			std::memmove(out_map + tri_count * 3, out_map + tri_offsets[i] * 3, out_face_counts[i] * 3 * sizeof(int64_t));
 		}
+		tri_count += out_face_counts[i];
+	}
 
-		face_index_offset += npolys;
+	if (tri_count != max_tris) {
+		triangulated_face_vertex_counts.resize(tri_count);
+		triangulated_face_vertex_indices.resize(tri_count * 3);
+		triangulated_to_orig_face_vertex_index_map.resize(tri_count * 3);
 	}
 
 	return true;
@@ -223,3 +290,56 @@ Basis apply_up_axis(const Basis &basis, const Vector3::Axis axis) {
 			basis[1],
 			-basis[2]);
 }
+
+Transform3D get_points_transform(const Vector3::Axis up_axis, real_t unit_scale, const Transform3D &geom_bind_transform) {
+	Basis basis = Basis().scaled(Vector3(unit_scale, unit_scale, unit_scale));
+	if (up_axis == Vector3::AXIS_Z) {
+		// Same swizzle as apply_up_axis on a Vector3
+		basis = Basis(unit_scale, 0, 0, 0, 0, unit_scale, 0, unit_scale, 0);
+	}
+	return Transform3D(basis, Vector3()) * geom_bind_transform;
+}
+
+void transform_points(const float *points, int64_t count, const Transform3D &transform, PackedVector3Array &r_points) {
+	r_points.resize(count);
+	if (count == 0) {
+		return;
+	}
+	Vector3 *dst = r_points.ptrw();
+
+	// The rows of the 3x4 matrix as plain floats keep the loop free of Vector3 temporaries so it vectorizes
+	float m[12];
+	for (int row = 0; row < 3; row++) {
+		for (int column = 0; column < 3; column++) {
+			m[row * 4 + column] = float(transform.basis[row][column]);
+		}
+		m[row * 4 + 3] = float(transform.origin[row]);
+	}
+
+	parallel_for_ranges(count, TRANSFORM_RANGE_SIZE, [&](int64_t begin, int64_t end) {
+		for (int64_t i = begin; i < end; i++) {
+			const float x = points[i * 3 + 0];
+			const float y = points[i * 3 + 1];
+			const float z = points[i * 3 + 2];
+			dst[i] = Vector3(
+					m[0] * x + m[1] * y + m[2] * z + m[3],
+					m[4] * x + m[5] * y + m[6] * z + m[7],
+					m[8] * x + m[9] * y + m[10] * z + m[11]);
+		}
+	}, "Transform USD points");
+}
+
+void transform_normals(PackedVector3Array &r_normals, const Basis &basis) {
+	if (r_normals.is_empty() || basis == Basis()) {
+		return;
+	}
+
+	// Inverse transpose, so normals stay perpendicular to the surface under non-uniform scale
+	const Basis normal_basis = basis.inverse().transposed();
+	Vector3 *normals = r_normals.ptrw();
+	parallel_for_ranges(r_normals.size(), TRANSFORM_RANGE_SIZE, [&](int64_t begin, int64_t end) {
+		for (int64_t i = begin; i < end; i++) {
+			normals[i] = normal_basis.xform(normals[i]).normalized();
+		}
+	}, "Transform USD normals");
+}
@@ -4,9 +4,12 @@
 #include "godot_cpp/variant/packed_int64_array.hpp"
 #include "godot_cpp/variant/packed_vector3_array.hpp"
 #include "godot_cpp/variant/string.hpp"
+#include "godot_cpp/variant/transform3d.hpp"
 #include "godot_cpp/variant/vector3.hpp"
 
 /// ported from tinyusdz/src/tydra/render-data.cc TriangulatePolygon
+/// Outputs are sized once up front, all-triangle meshes skip triangulation and very large meshes are split into face ranges
+/// that are triangulated on the WorkerThreadPool
 bool triangulate_polygon(
 		const godot::PackedVector3Array &points,
 		const godot::PackedInt32Array &face_vertex_counts,
@@ -30,3 +33,13 @@ godot::PackedVector3Array apply_up_axis(const godot::PackedVector3Array &array,
 godot::Transform3D apply_up_axis(const godot::Transform3D &transform, const godot::Vector3::Axis axis);
 
 godot::Basis apply_up_axis(const godot::Basis &basis, const godot::Vector3::Axis axis);
+
+/// Up axis swizzle, unit scale and geomBindTransform that take mesh points from USD to Godot space.
+/// The swizzle mirrors the mesh, so normals computed from the transformed points have to be negated if the determinant is negative
+godot::Transform3D get_points_transform(const godot::Vector3::Axis up_axis, real_t unit_scale, const godot::Transform3D &geom_bind_transform = godot::Transform3D());
+
+/// Reads count xyz float triples once and writes them transformed, large buffers are split into ranges on the WorkerThreadPool
+void transform_points(const float *points, int64_t count, const godot::Transform3D &transform, godot::PackedVector3Array &r_points);
+
+/// Transforms normals in place to match points transformed by basis
+void transform_normals(godot::PackedVector3Array &r_normals, const godot::Basis &basis);
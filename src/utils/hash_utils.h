@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+/// Incremental 64 bit hash for content comparison of large buffers, e.g. to find duplicate meshes.
+/// 32 bit hashes collide too often when there are thousands of meshes
+class ContentHasher {
+private:
+	uint64_t _hash = 0x9e3779b97f4a7c15ull;
+
+	static uint64_t _mix(uint64_t value) {
+		value ^= value >> 33;
+		value *= 0xff51afd7ed558ccdull;
+		value ^= value >> 33;
+		value *= 0xc4ceb9fe1a85ec53ull;
+		value ^= value >> 33;
+		return value;
+	}
+
+public:
+	void add(uint64_t value) {
+		_hash = (_hash ^ _mix(value)) * 0x100000001b3ull;
+	}
+
+	void add_buffer(const void *data, size_t size) {
+		const uint8_t *bytes = static_cast<const uint8_t *>(data);
+		add(size);
+
+		size_t i = 0;
+		for (; i + 8 <= size; i += 8) {
+			uint64_t word;
+			std::memcpy(&word, bytes + i, 8);
+			add(word);
+		}
+
+		if (i < size) {
+			uint64_t tail = 0;
+			std::memcpy(&tail, bytes + i, size - i);
+			add(tail);
+		}
+	}
+
+	uint64_t get() const { return _mix(_hash); }
+};
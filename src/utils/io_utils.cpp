@@ -0,0 +1,65 @@
+#include "utils/io_utils.h"
+
+#include <cstring>
+
+UsdFileFormat detect_usd_format(const uint8_t *data, size_t size) {
+	if (!data) {
+		return UsdFileFormat::UNKNOWN;
+	}
+
+	if (size >= 8 && std::memcmp(data, "PXR-USDC", 8) == 0) {
+		return UsdFileFormat::USDC;
+	}
+
+	if (size >= 5 && std::memcmp(data, "#usda", 5) == 0) {
+		return UsdFileFormat::USDA;
+	}
+
+	//usdz is a zip archive, local file header signature
+	if (size >= 4 && data[0] == 'P' && data[1] == 'K' && data[2] == 0x03 && data[3] == 0x04) {
+		return UsdFileFormat::USDZ;
+	}
+
+	return UsdFileFormat::UNKNOWN;
+}
+
+bool MappedFile::open(const std::string &path, std::string *err) {
+	close();
+
+	if (tinyusdz::io::MMapFile(path, &_handle, /* writable */ false, err)) {
+		_mapped = true;
+		return true;
+	}
+
+	// mmap is not available on every platform (or for every filesystem), reading is slower but always works
+	if (err) {
+		err->clear();
+	}
+	return tinyusdz::io::ReadWholeFile(&_buffer, err, path, /* filesize_max */ 0);
+}
+
+void MappedFile::close() {
+	if (_mapped) {
+		tinyusdz::io::UnmapFile(_handle, nullptr);
+		_handle = tinyusdz::io::MMapFileHandle();
+		_mapped = false;
+	}
+	_buffer.clear();
+	_buffer.shrink_to_fit();
+}
+
+bool MappedFile::is_open() const {
+	return _mapped || !_buffer.empty();
+}
+
+const uint8_t *MappedFile::data() const {
+	return _mapped ? _handle.addr : _buffer.data();
+}
+
+size_t MappedFile::size() const {
+	return _mapped ? static_cast<size_t>(_handle.size) : _buffer.size();
+}
+
+MappedFile::~MappedFile() {
+	close();
+}
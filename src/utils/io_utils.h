@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "io-util.hh"
+
+enum class UsdFileFormat {
+	USDA,
+	USDC,
+	USDZ,
+	UNKNOWN,
+};
+
+/// Detects the file format from the magic bytes, so .usd files work regardless of their encoding
+UsdFileFormat detect_usd_format(const uint8_t *data, size_t size);
+
+/// Read-only view of a whole file. Memory maps the file where tinyusdz supports it
+/// and only falls back to reading it into memory if mapping fails
+class MappedFile {
+private:
+	tinyusdz::io::MMapFileHandle _handle;
+	bool _mapped = false;
+	std::vector<uint8_t> _buffer;
+
+public:
+	bool open(const std::string &path, std::string *err);
+	void close();
+
+	bool is_open() const;
+	const uint8_t *data() const;
+	size_t size() const;
+
+	MappedFile() = default;
+	MappedFile(const MappedFile &) = delete;
+	MappedFile &operator=(const MappedFile &) = delete;
+	~MappedFile();
+};
@@ -0,0 +1,100 @@
+#include "utils/normal_utils.h"
+
+#include <algorithm>
+#include <vector>
+
+#include "godot_cpp/core/math.hpp"
+#include "godot_cpp/variant/array.hpp"
+#include "utils/thread_utils.h"
+
+using namespace godot;
+
+// Faces per WorkerThreadPool task
+static constexpr int64_t NORMALS_RANGE_SIZE = 16384;
+
+bool generate_normals(
+		const PackedVector3Array &points,
+		const PackedInt32Array &face_vertex_counts,
+		const PackedInt32Array &face_vertex_indices,
+		real_t crease_angle,
+		PackedVector3Array &r_normals,
+		String &error) {
+	const int64_t face_count = face_vertex_counts.size();
+	const int64_t point_count = points.size();
+	const int32_t *counts_ptr = face_vertex_counts.ptr();
+	const int32_t *indices_ptr = face_vertex_indices.ptr();
+	const Vector3 *points_ptr = points.ptr();
+
+	std::vector<int64_t> face_offsets(face_count + 1, 0);
+	for (int64_t face = 0; face < face_count; face++) {
+		face_offsets[face + 1] = face_offsets[face] + counts_ptr[face];
+	}
+	const int64_t corner_count = face_offsets[face_count];
+	if (corner_count > face_vertex_indices.size()) {
+		error = String("faceVertexCounts add up to {0} corners, but there are only {1} faceVertexIndices").format(Array::make(corner_count, face_vertex_indices.size()));
+		return false;
+	}
+
+	// Corners around every point, as ranges into point_corners
+	std::vector<int64_t> point_offsets(point_count + 1, 0);
+	for (int64_t corner = 0; corner < corner_count; corner++) {
+		const int32_t point = indices_ptr[corner];
+		if (point < 0 || point >= point_count) {
+			error = String("faceVertexIndices[{0}] = {1} is out of range for {2} points").format(Array::make(corner, point, point_count));
+			return false;
+		}
+		point_offsets[point + 1]++;
+	}
+	for (int64_t point = 0; point < point_count; point++) {
+		point_offsets[point + 1] += point_offsets[point];
+	}
+	std::vector<int64_t> point_corners(corner_count);
+	std::vector<int64_t> write_offsets(point_offsets.begin(), point_offsets.end() - 1);
+	for (int64_t corner = 0; corner < corner_count; corner++) {
+		point_corners[write_offsets[indices_ptr[corner]]++] = corner;
+	}
+
+	// Newell normals are robust for non planar polygons, the corner angles weight them so tessellation doesn't bias the average
+	std::vector<Vector3> face_normals(face_count);
+	std::vector<real_t> corner_angles(corner_count);
+	std::vector<int32_t> corner_faces(corner_count);
+	parallel_for_ranges(face_count, NORMALS_RANGE_SIZE, [&](int64_t begin, int64_t end) {
+		for (int64_t face = begin; face < end; face++) {
+			const int64_t offset = face_offsets[face];
+			const int32_t count = counts_ptr[face];
+			Vector3 normal;
+			for (int32_t i = 0; i < count; i++) {
+				const Vector3 &prev = points_ptr[indices_ptr[offset + (i + count - 1) % count]];
+				const Vector3 &current = points_ptr[indices_ptr[offset + i]];
+				const Vector3 &next = points_ptr[indices_ptr[offset + (i + 1) % count]];
+				normal += Vector3((current.y - next.y) * (current.z + next.z), (current.z - next.z) * (current.x + next.x), (current.x - next.x) * (current.y + next.y));
+				corner_angles[offset + i] = (prev - current).angle_to(next - current);
+				corner_faces[offset + i] = int32_t(face);
+			}
+			face_normals[face] = normal.normalized();
+		}
+	}, "Compute USD face normals");
+
+	const real_t min_dot = Math::cos(crease_angle);
+	r_normals.resize(corner_count);
+	Vector3 *normals_ptr = r_normals.ptrw();
+	parallel_for_ranges(face_count, NORMALS_RANGE_SIZE, [&](int64_t begin, int64_t end) {
+		for (int64_t face = begin; face < end; face++) {
+			const Vector3 &face_normal = face_normals[face];
+			for (int64_t corner = face_offsets[face]; corner < face_offsets[face + 1]; corner++) {
+				const int32_t point = indices_ptr[corner];
+				Vector3 normal;
+				for (int64_t i = point_offsets[point]; i < point_offsets[point + 1]; i++) {
+					const int64_t other_corner = point_corners[i];
+					const Vector3 &other_normal = face_normals[corner_faces[other_corner]];
+					if (face_normal.dot(other_normal) >= min_dot) {
+						normal += other_normal * corner_angles[other_corner];
+					}
+				}
+				normals_ptr[corner] = normal.is_zero_approx() ? face_normal : normal.normalized();
+			}
+		}
+	}, "Compute USD smooth normals");
+
+	return true;
+}
@@ -0,0 +1,15 @@
+#pragma once
+
+#include "godot_cpp/variant/packed_int32_array.hpp"
+#include "godot_cpp/variant/packed_vector3_array.hpp"
+#include "godot_cpp/variant/string.hpp"
+
+/// Angle weighted normals with one normal per face vertex. Faces around a point are only averaged when their normals are
+/// at most crease_angle (radians) apart, so hard edges stay hard. Face ranges are processed on the WorkerThreadPool
+bool generate_normals(
+		const godot::PackedVector3Array &points,
+		const godot::PackedInt32Array &face_vertex_counts,
+		const godot::PackedInt32Array &face_vertex_indices,
+		real_t crease_angle,
+		godot::PackedVector3Array &r_normals,
+		godot::String &error);
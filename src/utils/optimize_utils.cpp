@@ -0,0 +1,167 @@
+#include "utils/optimize_utils.h"
+
+#include <algorithm>
+
+using namespace godot;
+
+// Post-transform cache size Tipsify optimizes for, small enough to also suit GPUs with batched vertex reuse
+static constexpr int64_t VERTEX_CACHE_SIZE = 16;
+
+void optimize_vertex_cache(PackedInt32Array &r_indices, int64_t vertex_count, const PackedVector3Array &vertices) {
+	const int64_t triangle_count = r_indices.size() / 3;
+	if (triangle_count < 2) {
+		return;
+	}
+	const int32_t *indices_ptr = r_indices.ptr();
+
+	// Triangles around every vertex, and how many of them are still to be emitted
+	std::vector<int64_t> triangle_offsets(vertex_count + 1, 0);
+	for (int64_t corner = 0; corner < triangle_count * 3; corner++) {
+		triangle_offsets[indices_ptr[corner] + 1]++;
+	}
+	std::vector<int32_t> live_triangles(vertex_count);
+	for (int64_t vertex = 0; vertex < vertex_count; vertex++) {
+		live_triangles[vertex] = int32_t(triangle_offsets[vertex + 1]);
+		triangle_offsets[vertex + 1] += triangle_offsets[vertex];
+	}
+	std::vector<int32_t> vertex_triangles(triangle_count * 3);
+	std::vector<int64_t> write_offsets(triangle_offsets.begin(), triangle_offsets.end() - 1);
+	for (int64_t corner = 0; corner < triangle_count * 3; corner++) {
+		vertex_triangles[write_offsets[indices_ptr[corner]]++] = int32_t(corner / 3);
+	}
+
+	std::vector<int64_t> cache_times(vertex_count, 0);
+	std::vector<uint8_t> emitted(triangle_count, 0);
+	std::vector<int32_t> dead_end_stack;
+	std::vector<int32_t> candidates;
+	std::vector<int32_t> order;
+	order.reserve(triangle_count);
+	// Start of every cluster in order, a cluster ends where Tipsify has to restart from a vertex outside the cache
+	std::vector<int64_t> cluster_starts;
+	int64_t time = VERTEX_CACHE_SIZE + 1;
+	int32_t cursor = 0;
+
+	auto skip_dead_end = [&]() -> int32_t {
+		while (!dead_end_stack.empty()) {
+			const int32_t vertex = dead_end_stack.back();
+			dead_end_stack.pop_back();
+			if (live_triangles[vertex] > 0) {
+				return vertex;
+			}
+		}
+		for (; cursor < vertex_count; cursor++) {
+			if (live_triangles[cursor] > 0) {
+				return cursor;
+			}
+		}
+		return -1;
+	};
+
+	int32_t fan_vertex = skip_dead_end();
+	cluster_starts.push_back(0);
+	while (fan_vertex >= 0) {
+		candidates.clear();
+		for (int64_t i = triangle_offsets[fan_vertex]; i < triangle_offsets[fan_vertex + 1]; i++) {
+			const int32_t triangle = vertex_triangles[i];
+			if (emitted[triangle]) {
+				continue;
+			}
+			emitted[triangle] = 1;
+			order.push_back(triangle);
+			for (int corner = 0; corner < 3; corner++) {
+				const int32_t vertex = indices_ptr[triangle * 3 + corner];
+				dead_end_stack.push_back(vertex);
+				candidates.push_back(vertex);
+				live_triangles[vertex]--;
+				if (time - cache_times[vertex] > VERTEX_CACHE_SIZE) {
+					cache_times[vertex] = time++;
+				}
+			}
+		}
+
+		// Fan around the candidate that stays in the cache the longest while its remaining triangles are emitted
+		int32_t next_vertex = -1;
+		int64_t best_priority = -1;
+		for (const int32_t vertex : candidates) {
+			if (live_triangles[vertex] <= 0) {
+				continue;
+			}
+			int64_t priority = 0;
+			if (time - cache_times[vertex] + 2 * live_triangles[vertex] <= VERTEX_CACHE_SIZE) {
+				priority = time - cache_times[vertex];
+			}
+			if (priority > best_priority) {
+				best_priority = priority;
+				next_vertex = vertex;
+			}
+		}
+		if (next_vertex < 0) {
+			next_vertex = skip_dead_end();
+			if (next_vertex >= 0 && int64_t(order.size()) > cluster_starts.back()) {
+				cluster_starts.push_back(order.size());
+			}
+		}
+		fan_vertex = next_vertex;
+	}
+	cluster_starts.push_back(order.size());
+
+	// Clusters facing outwards from the center are drawn first, they are the most likely to occlude the rest
+	const int64_t cluster_count = int64_t(cluster_starts.size()) - 1;
+	std::vector<int64_t> cluster_order(cluster_count);
+	for (int64_t cluster = 0; cluster < cluster_count; cluster++) {
+		cluster_order[cluster] = cluster;
+	}
+	if (vertices.size() == vertex_count && cluster_count > 1) {
+		const Vector3 *vertices_ptr = vertices.ptr();
+		Vector3 center;
+		for (int64_t corner = 0; corner < triangle_count * 3; corner++) {
+			center += vertices_ptr[indices_ptr[corner]];
+		}
+		center /= real_t(triangle_count * 3);
+
+		std::vector<real_t> cluster_sort_keys(cluster_count);
+		for (int64_t cluster = 0; cluster < cluster_count; cluster++) {
+			Vector3 cluster_center;
+			Vector3 cluster_normal;
+			for (int64_t i = cluster_starts[cluster]; i < cluster_starts[cluster + 1]; i++) {
+				const int32_t *triangle = indices_ptr + int64_t(order[i]) * 3;
+				const Vector3 &a = vertices_ptr[triangle[0]];
+				const Vector3 &b = vertices_ptr[triangle[1]];
+				const Vector3 &c = vertices_ptr[triangle[2]];
+				cluster_center += a + b + c;
+				cluster_normal += (b - a).cross(c - a);
+			}
+			cluster_center /= real_t((cluster_starts[cluster + 1] - cluster_starts[cluster]) * 3);
+			cluster_sort_keys[cluster] = (cluster_center - center).dot(cluster_normal.normalized());
+		}
+		std::stable_sort(cluster_order.begin(), cluster_order.end(), [&](int64_t a, int64_t b) {
+			return cluster_sort_keys[a] > cluster_sort_keys[b];
+		});
+	}
+
+	PackedInt32Array optimized;
+	optimized.resize(triangle_count * 3);
+	int32_t *optimized_ptr = optimized.ptrw();
+	for (const int64_t cluster : cluster_order) {
+		for (int64_t i = cluster_starts[cluster]; i < cluster_starts[cluster + 1]; i++) {
+			std::copy_n(indices_ptr + int64_t(order[i]) * 3, 3, optimized_ptr);
+			optimized_ptr += 3;
+		}
+	}
+	r_indices = optimized;
+}
+
+void get_vertex_fetch_remap(const PackedInt32Array &indices, int64_t vertex_count, std::vector<int32_t> &r_remap) {
+	r_remap.assign(vertex_count, -1);
+	int32_t next_vertex = 0;
+	for (const int32_t vertex : indices) {
+		if (r_remap[vertex] < 0) {
+			r_remap[vertex] = next_vertex++;
+		}
+	}
+	for (int64_t vertex = 0; vertex < vertex_count; vertex++) {
+		if (r_remap[vertex] < 0) {
+			r_remap[vertex] = next_vertex++;
+		}
+	}
+}
@@ -0,0 +1,13 @@
+#pragma once
+
+#include <vector>
+
+#include "godot_cpp/variant/packed_int32_array.hpp"
+#include "godot_cpp/variant/packed_vector3_array.hpp"
+
+/// Reorders the triangles for the post-transform vertex cache with Tipsify. With vertices, the clusters Tipsify produces are
+/// then sorted so the ones facing away from the surface's center draw first, which lowers overdraw on convex parts
+void optimize_vertex_cache(godot::PackedInt32Array &r_indices, int64_t vertex_count, const godot::PackedVector3Array &vertices = godot::PackedVector3Array());
+
+/// New index of every vertex so they are stored in the order indices first uses them, unused vertices go last
+void get_vertex_fetch_remap(const godot::PackedInt32Array &indices, int64_t vertex_count, std::vector<int32_t> &r_remap);
@@ -0,0 +1,26 @@
+#include "utils/prim_index.h"
+
+void PrimIndex::_add(const tinyusdz::Prim &prim) {
+	_prims.emplace(prim.absolute_path().prim_part(), &prim);
+
+	for (const tinyusdz::Prim &child : prim.children()) {
+		_add(child);
+	}
+}
+
+void PrimIndex::build(const tinyusdz::Stage &stage) {
+	_prims.clear();
+
+	for (const tinyusdz::Prim &prim : stage.root_prims()) {
+		_add(prim);
+	}
+}
+
+const tinyusdz::Prim *PrimIndex::find(const tinyusdz::Path &path) const {
+	return find(path.prim_part());
+}
+
+const tinyusdz::Prim *PrimIndex::find(const std::string &prim_path) const {
+	auto it = _prims.find(prim_path);
+	return it != _prims.end() ? it->second : nullptr;
+}
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <string>
+#include <unordered_map>
+
+#include "prim-types.hh"
+#include "stage.hh"
+
+/// Maps absolute prim paths to the prims of a stage, built once so lookups don't walk the hierarchy.
+/// The pointers are only valid as long as the stage isn't modified
+class PrimIndex {
+private:
+	std::unordered_map<std::string, const tinyusdz::Prim *> _prims;
+
+	void _add(const tinyusdz::Prim &prim);
+
+public:
+	void build(const tinyusdz::Stage &stage);
+
+	/// Returns nullptr if there is no prim at path
+	const tinyusdz::Prim *find(const tinyusdz::Path &path) const;
+	const tinyusdz::Prim *find(const std::string &prim_path) const;
+
+	size_t size() const { return _prims.size(); }
+};
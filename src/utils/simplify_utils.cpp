@@ -0,0 +1,305 @@
+#include "utils/simplify_utils.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "godot_cpp/core/math.hpp"
+#include "godot_cpp/templates/hash_map.hpp"
+#include "godot_cpp/templates/hashfuncs.hpp"
+
+using namespace godot;
+
+// Surfaces with fewer triangles don't get LODs, and the chain stops once a level would go below it
+static constexpr int64_t LOD_MIN_TRIANGLES = 64;
+// A level has to drop at least this fraction of the previous level's triangles to be kept
+static constexpr double LOD_MIN_REDUCTION = 0.1;
+// Weight of squared normal and uv differences, relative to the squared length of the collapsed edge
+static constexpr double ATTRIBUTE_WEIGHT = 0.5;
+
+// Symmetric 4x4 plane quadric, with the summed plane weights to turn its error into a mean squared distance
+struct Quadric {
+	double a00 = 0.0, a01 = 0.0, a02 = 0.0, a03 = 0.0;
+	double a11 = 0.0, a12 = 0.0, a13 = 0.0;
+	double a22 = 0.0, a23 = 0.0;
+	double a33 = 0.0;
+	double weight = 0.0;
+
+	void add_plane(const Vector3 &normal, double distance, double plane_weight) {
+		const double x = normal.x, y = normal.y, z = normal.z;
+		a00 += plane_weight * x * x;
+		a01 += plane_weight * x * y;
+		a02 += plane_weight * x * z;
+		a03 += plane_weight * x * distance;
+		a11 += plane_weight * y * y;
+		a12 += plane_weight * y * z;
+		a13 += plane_weight * y * distance;
+		a22 += plane_weight * z * z;
+		a23 += plane_weight * z * distance;
+		a33 += plane_weight * distance * distance;
+		weight += plane_weight;
+	}
+
+	void add(const Quadric &other) {
+		a00 += other.a00;
+		a01 += other.a01;
+		a02 += other.a02;
+		a03 += other.a03;
+		a11 += other.a11;
+		a12 += other.a12;
+		a13 += other.a13;
+		a22 += other.a22;
+		a23 += other.a23;
+		a33 += other.a33;
+		weight += other.weight;
+	}
+
+	double error(const Vector3 &point) const {
+		const double x = point.x, y = point.y, z = point.z;
+		const double value = a00 * x * x + a11 * y * y + a22 * z * z + a33 +
+				2.0 * (a01 * x * y + a02 * x * z + a12 * y * z + a03 * x + a13 * y + a23 * z);
+		return weight > 0.0 ? std::max(value / weight, 0.0) : 0.0;
+	}
+};
+
+struct Collapse {
+	int32_t from = -1;
+	int32_t to = -1;
+	double cost = std::numeric_limits<double>::infinity();
+	double distance_error = 0.0;
+};
+
+struct PositionHasher {
+	static _FORCE_INLINE_ uint32_t hash(const Vector3 &position) {
+		uint32_t h = hash_murmur3_one_real(position.x);
+		h = hash_murmur3_one_real(position.y, h);
+		h = hash_murmur3_one_real(position.z, h);
+		return hash_fmix32(h);
+	}
+};
+
+// Triangles around every vertex of the current index buffer, as ranges into vertex_triangles
+static void build_vertex_triangles(const std::vector<int32_t> &indices, int64_t vertex_count, std::vector<int64_t> &r_offsets, std::vector<int32_t> &r_triangles) {
+	r_offsets.assign(vertex_count + 1, 0);
+	for (const int32_t vertex : indices) {
+		r_offsets[vertex + 1]++;
+	}
+	for (int64_t vertex = 0; vertex < vertex_count; vertex++) {
+		r_offsets[vertex + 1] += r_offsets[vertex];
+	}
+	r_triangles.resize(indices.size());
+	std::vector<int64_t> write_offsets(r_offsets.begin(), r_offsets.end() - 1);
+	for (size_t corner = 0; corner < indices.size(); corner++) {
+		r_triangles[write_offsets[indices[corner]]++] = int32_t(corner / 3);
+	}
+}
+
+void generate_lod_chain(
+		const PackedVector3Array &vertices,
+		const PackedVector3Array &normals,
+		const PackedVector2Array &uvs,
+		const PackedInt32Array &source_indices,
+		std::vector<SimplifiedLod> &r_lods) {
+	r_lods.clear();
+	const int64_t vertex_count = vertices.size();
+	const int64_t source_triangle_count = source_indices.size() / 3;
+	if (source_triangle_count < LOD_MIN_TRIANGLES * 2) {
+		return;
+	}
+
+	const Vector3 *vertices_ptr = vertices.ptr();
+	const bool has_normals = normals.size() == vertex_count;
+	const bool has_uvs = uvs.size() == vertex_count;
+
+	// Welded vertices split at seams, so vertices sharing a position are one point of the surface
+	HashMap<Vector3, int32_t, PositionHasher> position_groups;
+	std::vector<int32_t> vertex_groups(vertex_count);
+	std::vector<int32_t> group_sizes;
+	for (int64_t vertex = 0; vertex < vertex_count; vertex++) {
+		HashMap<Vector3, int32_t, PositionHasher>::Iterator found = position_groups.find(vertices_ptr[vertex]);
+		if (found != position_groups.end()) {
+			vertex_groups[vertex] = found->value;
+			group_sizes[found->value]++;
+		} else {
+			vertex_groups[vertex] = int32_t(group_sizes.size());
+			position_groups.insert(vertices_ptr[vertex], int32_t(group_sizes.size()));
+			group_sizes.push_back(1);
+		}
+	}
+
+	std::vector<int32_t> indices(source_indices.ptr(), source_indices.ptr() + source_triangle_count * 3);
+
+	// A point is locked if it lies on a seam or on an edge that only one triangle uses, collapsing it would tear or shrink the surface
+	std::vector<uint8_t> group_locked(group_sizes.size(), 0);
+	for (size_t group = 0; group < group_sizes.size(); group++) {
+		group_locked[group] = group_sizes[group] > 1;
+	}
+	HashMap<uint64_t, int32_t> directed_edges;
+	for (size_t corner = 0; corner < indices.size(); corner++) {
+		const uint32_t a = vertex_groups[indices[corner]];
+		const uint32_t b = vertex_groups[indices[corner - corner % 3 + (corner + 1) % 3]];
+		directed_edges[(uint64_t(a) << 32) | b]++;
+	}
+	for (const KeyValue<uint64_t, int32_t> &edge : directed_edges) {
+		const uint64_t reverse = (edge.key << 32) | (edge.key >> 32);
+		const int32_t *reverse_count = directed_edges.getptr(reverse);
+		if (edge.value != 1 || !reverse_count || *reverse_count != 1) {
+			group_locked[edge.key >> 32] = 1;
+			group_locked[edge.key & 0xffffffff] = 1;
+		}
+	}
+
+	// Area weighted plane quadrics of the triangles around every point
+	std::vector<Quadric> quadrics(group_sizes.size());
+	for (int64_t triangle = 0; triangle < source_triangle_count; triangle++) {
+		const Vector3 &p0 = vertices_ptr[indices[triangle * 3]];
+		const Vector3 cross = (vertices_ptr[indices[triangle * 3 + 1]] - p0).cross(vertices_ptr[indices[triangle * 3 + 2]] - p0);
+		const real_t length = cross.length();
+		if (length <= 0.0) {
+			continue;
+		}
+		const Vector3 normal = cross / length;
+		const double distance = -normal.dot(p0);
+		for (int corner = 0; corner < 3; corner++) {
+			quadrics[vertex_groups[indices[triangle * 3 + corner]]].add_plane(normal, distance, length * 0.5);
+		}
+	}
+
+	auto collapse_cost = [&](int32_t from, int32_t to, Collapse &r_collapse) {
+		const Vector3 &target = vertices_ptr[to];
+		r_collapse.from = from;
+		r_collapse.to = to;
+		r_collapse.distance_error = quadrics[vertex_groups[from]].error(target);
+		double attribute_error = 0.0;
+		if (has_normals) {
+			attribute_error += normals[from].distance_squared_to(normals[to]);
+		}
+		if (has_uvs) {
+			attribute_error += uvs[from].distance_squared_to(uvs[to]);
+		}
+		r_collapse.cost = r_collapse.distance_error + ATTRIBUTE_WEIGHT * attribute_error * vertices_ptr[from].distance_squared_to(target);
+	};
+
+	std::vector<int64_t> triangle_offsets;
+	std::vector<int32_t> vertex_triangles;
+	std::vector<Collapse> best_collapses(vertex_count);
+	std::vector<Collapse> candidates;
+	std::vector<uint8_t> touched(vertex_count);
+	std::vector<int32_t> collapse_targets(vertex_count);
+	double max_distance_error = 0.0;
+	float previous_error = 0.0;
+
+	int64_t triangle_count = source_triangle_count;
+	int64_t lod_triangle_count = source_triangle_count;
+	while (lod_triangle_count / 2 >= LOD_MIN_TRIANGLES) {
+		const int64_t target_triangle_count = lod_triangle_count / 2;
+
+		// Passes of independent collapses, cheapest first, until the level's triangle count is reached or nothing can collapse
+		while (triangle_count > target_triangle_count) {
+			build_vertex_triangles(indices, vertex_count, triangle_offsets, vertex_triangles);
+
+			std::fill(best_collapses.begin(), best_collapses.end(), Collapse());
+			for (size_t corner = 0; corner < indices.size(); corner++) {
+				const int32_t from = indices[corner];
+				if (group_locked[vertex_groups[from]]) {
+					continue;
+				}
+				const size_t triangle_start = corner - corner % 3;
+				for (int other = 1; other < 3; other++) {
+					Collapse collapse;
+					collapse_cost(from, indices[triangle_start + (corner + other) % 3], collapse);
+					if (collapse.cost < best_collapses[from].cost) {
+						best_collapses[from] = collapse;
+					}
+				}
+			}
+
+			candidates.clear();
+			for (const Collapse &collapse : best_collapses) {
+				if (collapse.from >= 0) {
+					candidates.push_back(collapse);
+				}
+			}
+			std::sort(candidates.begin(), candidates.end(), [](const Collapse &a, const Collapse &b) { return a.cost < b.cost; });
+
+			std::fill(touched.begin(), touched.end(), 0);
+			for (int64_t vertex = 0; vertex < vertex_count; vertex++) {
+				collapse_targets[vertex] = int32_t(vertex);
+			}
+
+			int64_t removed_triangles = 0;
+			for (const Collapse &collapse : candidates) {
+				if (triangle_count - removed_triangles <= target_triangle_count) {
+					break;
+				}
+				if (touched[collapse.from] || touched[collapse.to]) {
+					continue;
+				}
+
+				// Moving from onto to must not flip any triangle that survives the collapse
+				bool flips = false;
+				int64_t collapsed_triangles = 0;
+				const Vector3 &target = vertices_ptr[collapse.to];
+				for (int64_t i = triangle_offsets[collapse.from]; i < triangle_offsets[collapse.from + 1] && !flips; i++) {
+					const int32_t *triangle = indices.data() + int64_t(vertex_triangles[i]) * 3;
+					if (triangle[0] == collapse.to || triangle[1] == collapse.to || triangle[2] == collapse.to) {
+						collapsed_triangles++;
+						continue;
+					}
+					const int corner = triangle[0] == collapse.from ? 0 : (triangle[1] == collapse.from ? 1 : 2);
+					const Vector3 &a = vertices_ptr[triangle[(corner + 1) % 3]];
+					const Vector3 &b = vertices_ptr[triangle[(corner + 2) % 3]];
+					const Vector3 old_normal = (a - vertices_ptr[collapse.from]).cross(b - vertices_ptr[collapse.from]);
+					const Vector3 new_normal = (a - target).cross(b - target);
+					flips = old_normal.dot(new_normal) <= 0.0;
+				}
+				if (flips) {
+					continue;
+				}
+
+				collapse_targets[collapse.from] = collapse.to;
+				for (int64_t i = triangle_offsets[collapse.from]; i < triangle_offsets[collapse.from + 1]; i++) {
+					const int32_t *triangle = indices.data() + int64_t(vertex_triangles[i]) * 3;
+					touched[triangle[0]] = 1;
+					touched[triangle[1]] = 1;
+					touched[triangle[2]] = 1;
+				}
+				quadrics[vertex_groups[collapse.to]].add(quadrics[vertex_groups[collapse.from]]);
+				max_distance_error = std::max(max_distance_error, collapse.distance_error);
+				removed_triangles += collapsed_triangles;
+			}
+
+			if (removed_triangles == 0) {
+				break;
+			}
+
+			// Remap the collapsed vertices and drop the triangles that became degenerate
+			size_t write = 0;
+			for (size_t read = 0; read < indices.size(); read += 3) {
+				const int32_t a = collapse_targets[indices[read]];
+				const int32_t b = collapse_targets[indices[read + 1]];
+				const int32_t c = collapse_targets[indices[read + 2]];
+				if (a != b && b != c && a != c) {
+					indices[write++] = a;
+					indices[write++] = b;
+					indices[write++] = c;
+				}
+			}
+			indices.resize(write);
+			triangle_count = int64_t(write / 3);
+		}
+
+		if (double(triangle_count) > double(lod_triangle_count) * (1.0 - LOD_MIN_REDUCTION)) {
+			break;
+		}
+		lod_triangle_count = triangle_count;
+
+		// Godot expects the LOD errors to grow along the chain
+		SimplifiedLod lod;
+		lod.error = std::max(float(std::sqrt(max_distance_error)), std::nextafter(previous_error, std::numeric_limits<float>::infinity()));
+		lod.indices.resize(indices.size());
+		std::copy(indices.begin(), indices.end(), lod.indices.ptrw());
+		previous_error = lod.error;
+		r_lods.push_back(lod);
+	}
+}
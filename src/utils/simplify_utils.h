@@ -0,0 +1,25 @@
+#pragma once
+
+#include <vector>
+
+#include "godot_cpp/variant/packed_int32_array.hpp"
+#include "godot_cpp/variant/packed_vector2_array.hpp"
+#include "godot_cpp/variant/packed_vector3_array.hpp"
+
+/// One level of a LOD chain, indexing into the vertices of the full detail surface
+struct SimplifiedLod {
+	godot::PackedInt32Array indices;
+	/// Largest distance to the full detail surface the collapses introduced, in mesh units
+	float error = 0.0;
+};
+
+/// Builds a LOD chain by quadric error edge collapse that halves the triangle count per level, like Godot's own LOD generation.
+/// Vertices only ever collapse onto neighbours, so the LODs reuse the welded vertices of the surface. Vertices on uv or normal seams
+/// and on open borders stay in place, and differences in normals and uvs add to the cost of a collapse.
+/// normals and uvs may be empty
+void generate_lod_chain(
+		const godot::PackedVector3Array &vertices,
+		const godot::PackedVector3Array &normals,
+		const godot::PackedVector2Array &uvs,
+		const godot::PackedInt32Array &indices,
+		std::vector<SimplifiedLod> &r_lods);
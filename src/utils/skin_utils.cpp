@@ -0,0 +1,68 @@
+#include "utils/skin_utils.h"
+
+#include <algorithm>
+
+#include "godot_cpp/variant/array.hpp"
+
+using namespace godot;
+
+bool build_point_skin(
+		const PackedInt32Array &joint_indices,
+		const PackedFloat32Array &joint_weights,
+		int element_size,
+		bool constant,
+		int point_count,
+		PointSkin &r_skin,
+		String &error) {
+	if (element_size < 1) {
+		error = String("Invalid skin elementSize {0}").format(Array::make(element_size));
+		return false;
+	}
+
+	const int64_t influence_sets = constant ? 1 : point_count;
+	if (joint_indices.size() < influence_sets * element_size || joint_weights.size() < influence_sets * element_size) {
+		error = String("Expected {0} joint influences, but got {1} indices and {2} weights").format(Array::make(influence_sets * element_size, joint_indices.size(), joint_weights.size()));
+		return false;
+	}
+
+	const int influence_count = element_size > 4 ? 8 : 4;
+	const int kept_count = std::min(element_size, influence_count);
+	r_skin.influence_count = influence_count;
+	r_skin.bones.assign(size_t(point_count) * influence_count, 0);
+	r_skin.weights.assign(size_t(point_count) * influence_count, 0.0f);
+
+	const int32_t *indices_ptr = joint_indices.ptr();
+	const float *weights_ptr = joint_weights.ptr();
+
+	std::vector<int> order(element_size);
+	for (int point = 0; point < point_count; point++) {
+		const int64_t src = (constant ? 0 : point) * int64_t(element_size);
+		const size_t dst = size_t(point) * influence_count;
+
+		// Strongest influences first, so dropping the tail loses as little as possible
+		for (int k = 0; k < element_size; k++) {
+			order[k] = k;
+		}
+		if (element_size > kept_count) {
+			std::partial_sort(order.begin(), order.begin() + kept_count, order.end(), [&](int a, int b) {
+				return weights_ptr[src + a] > weights_ptr[src + b];
+			});
+		}
+
+		float weight_sum = 0.0f;
+		for (int k = 0; k < kept_count; k++) {
+			const float weight = std::max(weights_ptr[src + order[k]], 0.0f);
+			r_skin.bones[dst + k] = std::max(indices_ptr[src + order[k]], 0);
+			r_skin.weights[dst + k] = weight;
+			weight_sum += weight;
+		}
+
+		if (weight_sum > 0.0f) {
+			for (int k = 0; k < kept_count; k++) {
+				r_skin.weights[dst + k] /= weight_sum;
+			}
+		}
+	}
+
+	return true;
+}
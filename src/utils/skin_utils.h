@@ -0,0 +1,27 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "godot_cpp/variant/packed_float32_array.hpp"
+#include "godot_cpp/variant/packed_int32_array.hpp"
+#include "godot_cpp/variant/string.hpp"
+
+/// Skin influences per point in Godot's layout, influence_count bones and weights for every point
+struct PointSkin {
+	/// 4 or 8, the two counts Godot supports
+	int influence_count = 0;
+	std::vector<int32_t> bones;
+	std::vector<float> weights;
+};
+
+/// Reads skel:jointIndices/skel:jointWeights with element_size influences per point, keeps the strongest 4 or 8
+/// of them and renormalizes their weights. Constant interpolation (one set of influences for every point) is expanded to all points
+bool build_point_skin(
+		const godot::PackedInt32Array &joint_indices,
+		const godot::PackedFloat32Array &joint_weights,
+		int element_size,
+		bool constant,
+		int point_count,
+		PointSkin &r_skin,
+		godot::String &error);
@@ -0,0 +1,354 @@
+#include "utils/subdiv_utils.h"
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+#include "godot_cpp/variant/array.hpp"
+#include "godot_cpp/variant/vector2.hpp"
+#include "godot_cpp/variant/vector3.hpp"
+#include "utils/thread_utils.h"
+
+#include <opensubdiv/far/primvarRefiner.h>
+#include <opensubdiv/far/topologyDescriptor.h>
+
+using namespace godot;
+using namespace OpenSubdiv;
+
+// Primvar types in the form Far::PrimvarRefiner interpolates them
+struct SubdivPoint {
+	float x = 0;
+	float y = 0;
+	float z = 0;
+
+	void Clear() { x = y = z = 0; }
+	void AddWithWeight(const SubdivPoint &src, float weight) {
+		x += weight * src.x;
+		y += weight * src.y;
+		z += weight * src.z;
+	}
+};
+
+struct SubdivUV {
+	float u = 0;
+	float v = 0;
+
+	void Clear() { u = v = 0; }
+	void AddWithWeight(const SubdivUV &src, float weight) {
+		u += weight * src.u;
+		v += weight * src.v;
+	}
+};
+
+static Sdc::SchemeType to_scheme_type(SubdivScheme scheme) {
+	switch (scheme) {
+		case SubdivScheme::LOOP:
+			return Sdc::SCHEME_LOOP;
+		case SubdivScheme::BILINEAR:
+			return Sdc::SCHEME_BILINEAR;
+		default:
+			return Sdc::SCHEME_CATMARK;
+	}
+}
+
+static Sdc::Options::VtxBoundaryInterpolation to_boundary(SubdivBoundary boundary) {
+	switch (boundary) {
+		case SubdivBoundary::NONE:
+			return Sdc::Options::VTX_BOUNDARY_NONE;
+		case SubdivBoundary::EDGE_ONLY:
+			return Sdc::Options::VTX_BOUNDARY_EDGE_ONLY;
+		default:
+			return Sdc::Options::VTX_BOUNDARY_EDGE_AND_CORNER;
+	}
+}
+
+static Sdc::Options::FVarLinearInterpolation to_face_varying_linear(SubdivFaceVaryingLinear face_varying_linear) {
+	switch (face_varying_linear) {
+		case SubdivFaceVaryingLinear::NONE:
+			return Sdc::Options::FVAR_LINEAR_NONE;
+		case SubdivFaceVaryingLinear::CORNERS_ONLY:
+			return Sdc::Options::FVAR_LINEAR_CORNERS_ONLY;
+		case SubdivFaceVaryingLinear::CORNERS_PLUS2:
+			return Sdc::Options::FVAR_LINEAR_CORNERS_PLUS2;
+		case SubdivFaceVaryingLinear::BOUNDARIES:
+			return Sdc::Options::FVAR_LINEAR_BOUNDARIES;
+		case SubdivFaceVaryingLinear::ALL:
+			return Sdc::Options::FVAR_LINEAR_ALL;
+		default:
+			return Sdc::Options::FVAR_LINEAR_CORNERS_PLUS1;
+	}
+}
+
+// Interpolates a channel through all levels, buffer holds every level one after the other with the cage values first.
+// Returns the first value of the last level
+template <typename T, typename InterpolateFn>
+static T *refine_levels(const Far::TopologyRefiner &refiner, std::vector<T> &buffer, const std::vector<int> &level_sizes, InterpolateFn interpolate) {
+	T *src = buffer.data();
+	for (int level = 1; level <= refiner.GetMaxLevel(); level++) {
+		T *dst = src + level_sizes[level - 1];
+		interpolate(level, src, dst);
+		src = dst;
+	}
+	return src;
+}
+
+int64_t get_subdiv_triangle_count(SubdivScheme scheme, const PackedInt32Array &face_vertex_counts, int level) {
+	int64_t face_vertex_count = 0;
+	int64_t triangle_count = 0;
+	for (const int32_t count : face_vertex_counts) {
+		face_vertex_count += count;
+		triangle_count += std::max(count - 2, 0);
+	}
+
+	if (level < 1) {
+		return triangle_count;
+	}
+
+	// Loop splits every triangle into 4, the quad schemes turn an n-gon into n quads and then split every quad into 4
+	const int64_t growth = int64_t(1) << (2 * (level - 1));
+	if (scheme == SubdivScheme::LOOP) {
+		return face_vertex_counts.size() * growth * 4;
+	}
+	return face_vertex_count * growth * 2;
+}
+
+bool subdivide_cage(const SubdivCage &cage, int level, SubdivSurface &r_surface, String &error) {
+	const int point_count = cage.points.size();
+	const int face_count = cage.face_vertex_counts.size();
+	const int face_vertex_count = cage.face_vertex_indices.size();
+
+	if (level < 1) {
+		error = "Subdivision level must be at least 1";
+		return false;
+	}
+
+	// USD creases are chains of points, OpenSubdiv wants every edge on its own
+	std::vector<int> crease_pairs;
+	std::vector<float> crease_weights;
+	const bool per_edge_sharpness = cage.crease_sharpnesses.size() != cage.crease_lengths.size();
+	int64_t crease_offset = 0;
+	int64_t sharpness_idx = 0;
+	for (int chain = 0; chain < cage.crease_lengths.size(); chain++) {
+		const int length = cage.crease_lengths[chain];
+		if (length < 2 || crease_offset + length > cage.crease_indices.size()) {
+			error = String("Invalid creaseLengths[{0}] = {1}").format(Array::make(chain, length));
+			return false;
+		}
+
+		for (int edge = 0; edge < length - 1; edge++) {
+			const int64_t weight_idx = per_edge_sharpness ? sharpness_idx++ : chain;
+			crease_pairs.push_back(cage.crease_indices[crease_offset + edge]);
+			crease_pairs.push_back(cage.crease_indices[crease_offset + edge + 1]);
+			crease_weights.push_back(weight_idx < cage.crease_sharpnesses.size() ? cage.crease_sharpnesses[weight_idx] : 0.0f);
+		}
+		crease_offset += length;
+	}
+
+	// The UV channel always goes through face-varying interpolation so seams stay intact, per point uvs are indexed like the points
+	const bool has_uvs = cage.face_varying_uvs ? cage.uvs.size() == face_vertex_count : cage.uvs.size() == point_count;
+	Far::TopologyDescriptor::FVarChannel uv_channel;
+	uv_channel.numValues = cage.uvs.size();
+	uv_channel.valueIndices = cage.face_varying_uvs ? nullptr : cage.face_vertex_indices.ptr();
+
+	std::vector<int> face_varying_indices;
+	if (has_uvs && cage.face_varying_uvs) {
+		face_varying_indices.resize(face_vertex_count);
+		for (int i = 0; i < face_vertex_count; i++) {
+			face_varying_indices[i] = i;
+		}
+		uv_channel.valueIndices = face_varying_indices.data();
+	}
+
+	Far::TopologyDescriptor descriptor;
+	descriptor.numVertices = point_count;
+	descriptor.numFaces = face_count;
+	descriptor.numVertsPerFace = cage.face_vertex_counts.ptr();
+	descriptor.vertIndicesPerFace = cage.face_vertex_indices.ptr();
+	descriptor.numCreases = crease_weights.size();
+	descriptor.creaseVertexIndexPairs = crease_pairs.data();
+	descriptor.creaseWeights = crease_weights.data();
+	descriptor.numCorners = std::min(cage.corner_indices.size(), cage.corner_sharpnesses.size());
+	descriptor.cornerVertexIndices = cage.corner_indices.ptr();
+	descriptor.cornerWeights = cage.corner_sharpnesses.ptr();
+	descriptor.numHoles = cage.hole_indices.size();
+	descriptor.holeIndices = cage.hole_indices.ptr();
+	descriptor.numFVarChannels = has_uvs ? 1 : 0;
+	descriptor.fvarChannels = has_uvs ? &uv_channel : nullptr;
+
+	Sdc::Options options;
+	options.SetVtxBoundaryInterpolation(to_boundary(cage.boundary));
+	options.SetFVarLinearInterpolation(to_face_varying_linear(cage.face_varying_linear));
+
+	using RefinerFactory = Far::TopologyRefinerFactory<Far::TopologyDescriptor>;
+	std::unique_ptr<Far::TopologyRefiner> refiner(RefinerFactory::Create(descriptor, RefinerFactory::Options(to_scheme_type(cage.scheme), options)));
+	if (!refiner) {
+		error = "OpenSubdiv failed to build the topology of the cage";
+		return false;
+	}
+
+	Far::TopologyRefiner::UniformOptions refine_options(level);
+	refine_options.fullTopologyInLastLevel = true;
+	// Vertices that come from vertices are placed first and in their parent's order, which the coarse levels rely on
+	refine_options.orderVerticesFromFacesFirst = false;
+	refiner->RefineUniform(refine_options);
+
+	std::vector<int> vertex_level_sizes(level + 1);
+	std::vector<int> uv_level_sizes(level + 1);
+	std::vector<int> face_level_sizes(level + 1);
+	for (int i = 0; i <= level; i++) {
+		vertex_level_sizes[i] = refiner->GetLevel(i).GetNumVertices();
+		uv_level_sizes[i] = has_uvs ? refiner->GetLevel(i).GetNumFVarValues(0) : 0;
+		face_level_sizes[i] = refiner->GetLevel(i).GetNumFaces();
+	}
+
+	const Far::TopologyLevel &last_level = refiner->GetLevel(level);
+	const int refined_point_count = last_level.GetNumVertices();
+	const Far::PrimvarRefiner primvar_refiner(*refiner);
+
+	// Faces refined from holes are still in the last level, they are left out of every channel
+	std::vector<int> kept_faces;
+	kept_faces.reserve(last_level.GetNumFaces());
+	int kept_face_vertex_count = 0;
+	for (int face = 0; face < last_level.GetNumFaces(); face++) {
+		if (!last_level.IsFaceHole(face)) {
+			kept_faces.push_back(face);
+			kept_face_vertex_count += last_level.GetFaceVertices(face).size();
+		}
+	}
+	const int kept_face_count = kept_faces.size();
+
+	r_surface.points.resize(refined_point_count);
+	r_surface.normals.resize(refined_point_count);
+	r_surface.face_vertex_counts.resize(kept_face_count);
+	r_surface.face_vertex_indices.resize(kept_face_vertex_count);
+	r_surface.uvs.resize(has_uvs ? (cage.face_varying_uvs ? kept_face_vertex_count : refined_point_count) : 0);
+	r_surface.face_material_indices.resize(cage.face_material_indices.size() == face_count ? kept_face_count : 0);
+
+	// The channels only read the refiner, so each one is interpolated on its own worker
+	enum Channel {
+		CHANNEL_POSITIONS,
+		CHANNEL_UVS,
+		CHANNEL_MATERIALS,
+		CHANNEL_TOPOLOGY,
+		CHANNEL_MAX,
+	};
+
+	std::vector<int32_t> material_buffer;
+	parallel_for(CHANNEL_MAX, [&](uint32_t channel) {
+		switch (channel) {
+			case CHANNEL_POSITIONS: {
+				std::vector<SubdivPoint> buffer(refiner->GetNumVerticesTotal());
+				const Vector3 *cage_points = cage.points.ptr();
+				for (int i = 0; i < point_count; i++) {
+					buffer[i] = { float(cage_points[i].x), float(cage_points[i].y), float(cage_points[i].z) };
+				}
+
+				const SubdivPoint *last = refine_levels(*refiner, buffer, vertex_level_sizes, [&](int refine_level, const SubdivPoint *src, SubdivPoint *dst) {
+					primvar_refiner.Interpolate(refine_level, src, dst);
+				});
+
+				std::vector<SubdivPoint> limit_points(refined_point_count);
+				std::vector<SubdivPoint> limit_du(refined_point_count);
+				std::vector<SubdivPoint> limit_dv(refined_point_count);
+				primvar_refiner.Limit(last, limit_points, limit_du, limit_dv);
+
+				Vector3 *points_ptr = r_surface.points.ptrw();
+				Vector3 *normals_ptr = r_surface.normals.ptrw();
+				for (int i = 0; i < refined_point_count; i++) {
+					points_ptr[i] = Vector3(limit_points[i].x, limit_points[i].y, limit_points[i].z);
+					const Vector3 du(limit_du[i].x, limit_du[i].y, limit_du[i].z);
+					const Vector3 dv(limit_dv[i].x, limit_dv[i].y, limit_dv[i].z);
+					normals_ptr[i] = du.cross(dv).normalized();
+				}
+				break;
+			}
+			case CHANNEL_UVS: {
+				if (!has_uvs) {
+					break;
+				}
+
+				std::vector<SubdivUV> buffer(refiner->GetNumFVarValuesTotal(0));
+				const Vector2 *cage_uvs = cage.uvs.ptr();
+				for (int i = 0; i < cage.uvs.size(); i++) {
+					buffer[i] = { float(cage_uvs[i].x), float(cage_uvs[i].y) };
+				}
+
+				const SubdivUV *last = refine_levels(*refiner, buffer, uv_level_sizes, [&](int refine_level, const SubdivUV *src, SubdivUV *dst) {
+					primvar_refiner.InterpolateFaceVarying(refine_level, src, dst, 0);
+				});
+
+				std::vector<SubdivUV> limit_uvs(uv_level_sizes[level]);
+				primvar_refiner.LimitFaceVarying(last, limit_uvs, 0);
+
+				// Back to the layout of the cage, flattened per face vertex or per point
+				Vector2 *uvs_ptr = r_surface.uvs.ptrw();
+				int face_vertex = 0;
+				for (const int face : kept_faces) {
+					const Far::ConstIndexArray uv_indices = last_level.GetFaceFVarValues(face, 0);
+					const Far::ConstIndexArray vertex_indices = last_level.GetFaceVertices(face);
+					for (int corner = 0; corner < uv_indices.size(); corner++, face_vertex++) {
+						const SubdivUV &uv = limit_uvs[uv_indices[corner]];
+						uvs_ptr[cage.face_varying_uvs ? face_vertex : vertex_indices[corner]] = Vector2(uv.u, uv.v);
+					}
+				}
+				break;
+			}
+			case CHANNEL_MATERIALS: {
+				if (r_surface.face_material_indices.is_empty()) {
+					break;
+				}
+
+				material_buffer.resize(refiner->GetNumFacesTotal());
+				std::copy_n(cage.face_material_indices.ptr(), face_count, material_buffer.data());
+				const int32_t *last = refine_levels(*refiner, material_buffer, face_level_sizes, [&](int refine_level, const int32_t *src, int32_t *dst) {
+					primvar_refiner.InterpolateFaceUniform(refine_level, src, dst);
+				});
+				int32_t *materials_ptr = r_surface.face_material_indices.ptrw();
+				for (int i = 0; i < kept_face_count; i++) {
+					materials_ptr[i] = last[kept_faces[i]];
+				}
+				break;
+			}
+			case CHANNEL_TOPOLOGY: {
+				int32_t *counts_ptr = r_surface.face_vertex_counts.ptrw();
+				int32_t *indices_ptr = r_surface.face_vertex_indices.ptrw();
+				int face_vertex = 0;
+				for (int i = 0; i < kept_face_count; i++) {
+					const Far::ConstIndexArray vertex_indices = last_level.GetFaceVertices(kept_faces[i]);
+					counts_ptr[i] = vertex_indices.size();
+					for (int corner = 0; corner < vertex_indices.size(); corner++) {
+						indices_ptr[face_vertex++] = vertex_indices[corner];
+					}
+				}
+				break;
+			}
+		}
+	}, "Subdivide USD mesh");
+
+	r_surface.coarse_levels.clear();
+	r_surface.coarse_levels.resize(level);
+	int level_face_offset = 0;
+	for (int coarse = 0; coarse < level; coarse++) {
+		const Far::TopologyLevel &topology = refiner->GetLevel(coarse);
+		SubdivLevel &coarse_level = r_surface.coarse_levels[coarse];
+		const bool has_materials = !material_buffer.empty();
+
+		for (int face = 0; face < topology.GetNumFaces(); face++) {
+			if (topology.IsFaceHole(face)) {
+				continue;
+			}
+
+			const Far::ConstIndexArray vertex_indices = topology.GetFaceVertices(face);
+			coarse_level.face_vertex_counts.push_back(vertex_indices.size());
+			for (int corner = 0; corner < vertex_indices.size(); corner++) {
+				coarse_level.face_vertex_indices.push_back(vertex_indices[corner]);
+			}
+			if (has_materials) {
+				coarse_level.face_material_indices.push_back(material_buffer[level_face_offset + face]);
+			}
+		}
+		level_face_offset += face_level_sizes[coarse];
+	}
+
+	return true;
+}
@@ -0,0 +1,82 @@
+#pragma once
+
+#include "godot_cpp/variant/packed_float32_array.hpp"
+#include "godot_cpp/variant/packed_int32_array.hpp"
+#include "godot_cpp/variant/packed_vector2_array.hpp"
+#include "godot_cpp/variant/packed_vector3_array.hpp"
+#include "godot_cpp/variant/string.hpp"
+
+#include <vector>
+
+enum class SubdivScheme {
+	CATMULL_CLARK,
+	LOOP,
+	BILINEAR,
+};
+
+enum class SubdivBoundary {
+	NONE,
+	EDGE_ONLY,
+	EDGE_AND_CORNER,
+};
+
+enum class SubdivFaceVaryingLinear {
+	NONE,
+	CORNERS_ONLY,
+	CORNERS_PLUS1,
+	CORNERS_PLUS2,
+	BOUNDARIES,
+	ALL,
+};
+
+/// Control cage of a subdivision surface with its tags in USD layout
+struct SubdivCage {
+	SubdivScheme scheme = SubdivScheme::CATMULL_CLARK;
+	SubdivBoundary boundary = SubdivBoundary::EDGE_AND_CORNER;
+	SubdivFaceVaryingLinear face_varying_linear = SubdivFaceVaryingLinear::CORNERS_PLUS1;
+
+	godot::PackedVector3Array points;
+	godot::PackedInt32Array face_vertex_counts;
+	godot::PackedInt32Array face_vertex_indices;
+
+	/// Crease chains, crease_lengths[i] points each with one sharpness per chain or per edge
+	godot::PackedInt32Array crease_indices;
+	godot::PackedInt32Array crease_lengths;
+	godot::PackedFloat32Array crease_sharpnesses;
+	godot::PackedInt32Array corner_indices;
+	godot::PackedFloat32Array corner_sharpnesses;
+	godot::PackedInt32Array hole_indices;
+
+	/// Optional, per point or per face vertex
+	godot::PackedVector2Array uvs;
+	bool face_varying_uvs = false;
+	/// Optional, per face
+	godot::PackedInt32Array face_material_indices;
+};
+
+/// Faces of one refinement level, indexing into the points of the finest level
+struct SubdivLevel {
+	godot::PackedInt32Array face_vertex_counts;
+	godot::PackedInt32Array face_vertex_indices;
+	godot::PackedInt32Array face_material_indices;
+};
+
+/// Refined mesh evaluated at the limit surface, the channels keep the layout they had on the cage
+struct SubdivSurface {
+	godot::PackedVector3Array points;
+	godot::PackedVector3Array normals;
+	godot::PackedInt32Array face_vertex_counts;
+	godot::PackedInt32Array face_vertex_indices;
+	godot::PackedVector2Array uvs;
+	godot::PackedInt32Array face_material_indices;
+	/// Topology of the coarser levels, starting with the cage. Every vertex of a level continues as the vertex with the
+	/// same index on the next level, so these faces can be drawn with the points of the finest level
+	std::vector<SubdivLevel> coarse_levels;
+};
+
+/// Triangles the cage has after level refinements, for budgeting before refining anything
+int64_t get_subdiv_triangle_count(SubdivScheme scheme, const godot::PackedInt32Array &face_vertex_counts, int level);
+
+/// Uniformly refines the cage level times with OpenSubdiv and projects the last level to the limit surface.
+/// Positions, uvs and face materials are interpolated as separate channels on the WorkerThreadPool
+bool subdivide_cage(const SubdivCage &cage, int level, SubdivSurface &r_surface, godot::String &error);
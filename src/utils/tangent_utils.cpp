@@ -0,0 +1,96 @@
+#include "utils/tangent_utils.h"
+
+#include <vector>
+
+#include "godot_cpp/core/math.hpp"
+#include "utils/thread_utils.h"
+
+using namespace godot;
+
+// Triangles or vertices per WorkerThreadPool task
+static constexpr int64_t TANGENTS_RANGE_SIZE = 16384;
+
+void generate_tangents(
+		const PackedVector3Array &vertices,
+		const PackedVector3Array &normals,
+		const PackedVector2Array &uvs,
+		const PackedInt32Array &indices,
+		PackedFloat32Array &r_tangents) {
+	const int64_t vertex_count = vertices.size();
+	const int64_t triangle_count = indices.size() / 3;
+	const Vector3 *vertices_ptr = vertices.ptr();
+	const Vector3 *normals_ptr = normals.ptr();
+	const Vector2 *uvs_ptr = uvs.ptr();
+	const int32_t *indices_ptr = indices.ptr();
+
+	// Tangent frame of every triangle from its uv derivatives, plus the corner angles that weight it per vertex like MikkTSpace does
+	std::vector<Vector3> triangle_tangents(triangle_count);
+	std::vector<Vector3> triangle_bitangents(triangle_count);
+	std::vector<real_t> corner_angles(triangle_count * 3);
+	parallel_for_ranges(triangle_count, TANGENTS_RANGE_SIZE, [&](int64_t begin, int64_t end) {
+		for (int64_t triangle = begin; triangle < end; triangle++) {
+			const int32_t *corners = indices_ptr + triangle * 3;
+			const Vector3 edge1 = vertices_ptr[corners[1]] - vertices_ptr[corners[0]];
+			const Vector3 edge2 = vertices_ptr[corners[2]] - vertices_ptr[corners[0]];
+			const Vector2 uv_edge1 = uvs_ptr[corners[1]] - uvs_ptr[corners[0]];
+			const Vector2 uv_edge2 = uvs_ptr[corners[2]] - uvs_ptr[corners[0]];
+
+			const real_t determinant = uv_edge1.x * uv_edge2.y - uv_edge2.x * uv_edge1.y;
+			if (!Math::is_zero_approx(determinant)) {
+				const real_t inverse = 1.0 / determinant;
+				triangle_tangents[triangle] = (edge1 * uv_edge2.y - edge2 * uv_edge1.y) * inverse;
+				triangle_bitangents[triangle] = (edge2 * uv_edge1.x - edge1 * uv_edge2.x) * inverse;
+			}
+
+			for (int corner = 0; corner < 3; corner++) {
+				const Vector3 &current = vertices_ptr[corners[corner]];
+				const Vector3 &next = vertices_ptr[corners[(corner + 1) % 3]];
+				const Vector3 &prev = vertices_ptr[corners[(corner + 2) % 3]];
+				corner_angles[triangle * 3 + corner] = (next - current).angle_to(prev - current);
+			}
+		}
+	}, "Compute USD triangle tangents");
+
+	// Triangle corners around every vertex, as ranges into vertex_corners
+	std::vector<int64_t> vertex_offsets(vertex_count + 1, 0);
+	for (int64_t corner = 0; corner < triangle_count * 3; corner++) {
+		vertex_offsets[indices_ptr[corner] + 1]++;
+	}
+	for (int64_t vertex = 0; vertex < vertex_count; vertex++) {
+		vertex_offsets[vertex + 1] += vertex_offsets[vertex];
+	}
+	std::vector<int64_t> vertex_corners(triangle_count * 3);
+	std::vector<int64_t> write_offsets(vertex_offsets.begin(), vertex_offsets.end() - 1);
+	for (int64_t corner = 0; corner < triangle_count * 3; corner++) {
+		vertex_corners[write_offsets[indices_ptr[corner]]++] = corner;
+	}
+
+	r_tangents.resize(vertex_count * 4);
+	float *tangents_ptr = r_tangents.ptrw();
+	parallel_for_ranges(vertex_count, TANGENTS_RANGE_SIZE, [&](int64_t begin, int64_t end) {
+		for (int64_t vertex = begin; vertex < end; vertex++) {
+			Vector3 tangent;
+			Vector3 bitangent;
+			for (int64_t i = vertex_offsets[vertex]; i < vertex_offsets[vertex + 1]; i++) {
+				const int64_t corner = vertex_corners[i];
+				tangent += triangle_tangents[corner / 3] * corner_angles[corner];
+				bitangent += triangle_bitangents[corner / 3] * corner_angles[corner];
+			}
+
+			// Gram-Schmidt against the vertex normal, uv mirroring is kept in the sign
+			const Vector3 &normal = normals_ptr[vertex];
+			tangent = (tangent - normal * normal.dot(tangent)).normalized();
+			if (tangent.is_zero_approx()) {
+				tangent = normal.cross(Math::abs(normal.x) < 0.9 ? Vector3(1, 0, 0) : Vector3(0, 1, 0)).normalized();
+			}
+			// Godot's uvs run top down, so its binormal is the negated uv bitangent
+			const float sign = normal.cross(tangent).dot(-bitangent) < 0.0 ? -1.0 : 1.0;
+
+			float *dst = tangents_ptr + vertex * 4;
+			dst[0] = tangent.x;
+			dst[1] = tangent.y;
+			dst[2] = tangent.z;
+			dst[3] = sign;
+		}
+	}, "Compute USD vertex tangents");
+}
@@ -0,0 +1,15 @@
+#pragma once
+
+#include "godot_cpp/variant/packed_float32_array.hpp"
+#include "godot_cpp/variant/packed_int32_array.hpp"
+#include "godot_cpp/variant/packed_vector2_array.hpp"
+#include "godot_cpp/variant/packed_vector3_array.hpp"
+
+/// Tangents in the MikkTSpace convention for an indexed triangle surface, 4 floats per vertex as Godot's ARRAY_TANGENT
+/// expects them. Triangle and vertex ranges are processed on the WorkerThreadPool
+void generate_tangents(
+		const godot::PackedVector3Array &vertices,
+		const godot::PackedVector3Array &normals,
+		const godot::PackedVector2Array &uvs,
+		const godot::PackedInt32Array &indices,
+		godot::PackedFloat32Array &r_tangents);
@@ -0,0 +1,87 @@
+#include "utils/thread_utils.h"
+
+#include <algorithm>
+#include <vector>
+
+#include <godot_cpp/classes/os.hpp>
+#include <godot_cpp/classes/worker_thread_pool.hpp>
+#include <godot_cpp/variant/callable_method_pointer.hpp>
+
+using namespace godot;
+
+// Callables can't capture, so the std::function is passed as a bound pointer
+static void parallel_for_task(uint32_t index, int64_t fn_ptr) {
+	const std::function<void(uint32_t)> *fn = reinterpret_cast<const std::function<void(uint32_t)> *>(fn_ptr);
+	(*fn)(index);
+}
+
+struct NestedRange {
+	const std::function<void(uint32_t)> *fn = nullptr;
+	uint32_t begin = 0;
+	uint32_t end = 0;
+};
+
+static void run_nested_range(const NestedRange &range) {
+	for (uint32_t i = range.begin; i < range.end; i++) {
+		(*range.fn)(i);
+	}
+}
+
+static void parallel_for_nested_task(int64_t range_ptr) {
+	run_nested_range(*reinterpret_cast<const NestedRange *>(range_ptr));
+}
+
+// Waiting on a group blocks the thread without running other work, so a pool thread that waits on one while all others do the
+// same deadlocks. Single tasks are waited on collaboratively instead, the waiting thread runs queued tasks until its own are done
+static void parallel_for_nested(uint32_t count, const std::function<void(uint32_t)> &fn, const String &description) {
+	const uint32_t range_count = std::min(count, uint32_t(std::max(OS::get_singleton()->get_processor_count(), 1)));
+	std::vector<NestedRange> ranges(range_count);
+	for (uint32_t range_idx = 0; range_idx < range_count; range_idx++) {
+		ranges[range_idx].fn = &fn;
+		ranges[range_idx].begin = uint32_t(uint64_t(count) * range_idx / range_count);
+		ranges[range_idx].end = uint32_t(uint64_t(count) * (range_idx + 1) / range_count);
+	}
+
+	WorkerThreadPool *pool = WorkerThreadPool::get_singleton();
+	std::vector<int64_t> task_ids(range_count, -1);
+	for (uint32_t range_idx = 1; range_idx < range_count; range_idx++) {
+		Callable task = callable_mp_static(&parallel_for_nested_task).bind(reinterpret_cast<int64_t>(&ranges[range_idx]));
+		task_ids[range_idx] = pool->add_task(task, true, description);
+	}
+
+	// The first range runs on the calling thread, it would only wait otherwise
+	run_nested_range(ranges[0]);
+
+	for (uint32_t range_idx = 1; range_idx < range_count; range_idx++) {
+		pool->wait_for_task_completion(task_ids[range_idx]);
+	}
+}
+
+void parallel_for(uint32_t count, const std::function<void(uint32_t)> &fn, const String &description) {
+	if (count == 0) {
+		return;
+	}
+
+	if (count == 1) {
+		fn(0);
+		return;
+	}
+
+	WorkerThreadPool *pool = WorkerThreadPool::get_singleton();
+	if (pool->get_caller_task_id() != -1 || pool->get_caller_group_id() != -1) {
+		parallel_for_nested(count, fn, description);
+		return;
+	}
+
+	Callable task = callable_mp_static(&parallel_for_task).bind(reinterpret_cast<int64_t>(&fn));
+	int64_t group_id = pool->add_group_task(task, count, -1, true, description);
+	pool->wait_for_group_task_completion(group_id);
+}
+
+void parallel_for_ranges(int64_t count, int64_t range_size, const std::function<void(int64_t, int64_t)> &fn, const String &description) {
+	const uint32_t range_count = uint32_t((count + range_size - 1) / range_size);
+	parallel_for(range_count, [&](uint32_t range_idx) {
+		const int64_t begin = range_idx * range_size;
+		fn(begin, std::min(begin + range_size, count));
+	}, description);
+}
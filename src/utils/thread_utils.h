@@ -0,0 +1,15 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+
+#include <godot_cpp/variant/string.hpp>
+
+/// Runs fn(index) for every index in [0, count) as a WorkerThreadPool group task and waits until all are done.
+/// A count of 1 runs inline. Called from a pool thread, e.g. nested in another parallel_for, the work is split into at most one
+/// task per core that are waited on collaboratively, so nesting can't starve the pool
+void parallel_for(uint32_t count, const std::function<void(uint32_t)> &fn, const godot::String &description);
+
+/// Splits [0, count) into ranges of at most range_size and runs fn(begin, end) for each of them like parallel_for.
+/// For per element work that is too small to be its own task
+void parallel_for_ranges(int64_t count, int64_t range_size, const std::function<void(int64_t, int64_t)> &fn, const godot::String &description);
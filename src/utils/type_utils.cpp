@@ -2,6 +2,7 @@
 #include "godot_cpp/variant/variant.hpp"
 #include "value-types.hh"
 #include <cstdint>
+#include <cstring>
 
 godot::Variant single_value_to_variant(const tinyusdz::value::Value &usd_value, uint32_t type_id);
 godot::Variant array_value_to_variant(const tinyusdz::value::Value &usd_value, uint32_t type_id);
@@ -20,6 +21,46 @@ godot::Variant to_variant(const tinyusdz::value::Value &usd_value) {
 	}
 }
 
+godot::PackedVector2Array to_packed_array(const std::vector<tinyusdz::value::texcoord2f> &values) {
+	godot::PackedVector2Array result;
+	result.resize(values.size());
+	godot::Vector2 *dst = result.ptrw();
+
+	if constexpr (sizeof(godot::Vector2) == sizeof(tinyusdz::value::texcoord2f)) {
+		std::memcpy(dst, values.data(), values.size() * sizeof(godot::Vector2));
+	} else {
+		for (size_t i = 0; i < values.size(); i++) {
+			dst[i] = godot::Vector2(values[i][0], values[i][1]);
+		}
+	}
+	return result;
+}
+
+godot::PackedColorArray to_packed_array(const std::vector<tinyusdz::value::color3f> &values) {
+	godot::PackedColorArray result;
+	result.resize(values.size());
+	godot::Color *dst = result.ptrw();
+
+	for (size_t i = 0; i < values.size(); i++) {
+		dst[i] = godot::Color(values[i][0], values[i][1], values[i][2]);
+	}
+	return result;
+}
+
+godot::PackedFloat32Array to_packed_array(const std::vector<float> &values) {
+	godot::PackedFloat32Array result;
+	result.resize(values.size());
+	std::memcpy(result.ptrw(), values.data(), values.size() * sizeof(float));
+	return result;
+}
+
+godot::PackedInt32Array to_packed_array(const std::vector<int32_t> &values) {
+	godot::PackedInt32Array result;
+	result.resize(values.size());
+	std::memcpy(result.ptrw(), values.data(), values.size() * sizeof(int32_t));
+	return result;
+}
+
 godot::Variant single_value_to_variant(const tinyusdz::value::Value &usd_value, uint32_t type_id) {
 	godot::Variant result;
 	switch (type_id) {
@@ -2,6 +2,10 @@
 
 #include <godot_cpp/variant/basis.hpp>
 #include <godot_cpp/variant/color.hpp>
+#include <godot_cpp/variant/packed_color_array.hpp>
+#include <godot_cpp/variant/packed_float32_array.hpp>
+#include <godot_cpp/variant/packed_int32_array.hpp>
+#include <godot_cpp/variant/packed_vector2_array.hpp>
 #include <godot_cpp/variant/quaternion.hpp>
 #include <godot_cpp/variant/string.hpp>
 #include <godot_cpp/variant/transform3d.hpp>
@@ -15,6 +19,12 @@
 // This handles all the supported types
 godot::Variant to_variant(const tinyusdz::value::Value &usd_value);
 
+// Bulk copies of tinyusdz arrays into packed arrays, without going through Variant per element
+godot::PackedVector2Array to_packed_array(const std::vector<tinyusdz::value::texcoord2f> &values);
+godot::PackedColorArray to_packed_array(const std::vector<tinyusdz::value::color3f> &values);
+godot::PackedFloat32Array to_packed_array(const std::vector<float> &values);
+godot::PackedInt32Array to_packed_array(const std::vector<int32_t> &values);
+
 // TODO check if something like this really doesn't already exist
 inline godot::Variant::Type get_godot_type(const godot::Vector3 &) { return godot::Variant::VECTOR3; }
 inline godot::Variant::Type get_godot_type(const godot::Transform3D &) { return godot::Variant::TRANSFORM3D; }
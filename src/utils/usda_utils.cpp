@@ -0,0 +1,340 @@
+#include "utils/usda_utils.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace {
+
+struct TextRange {
+	size_t begin = 0;
+	size_t end = 0;
+
+	size_t size() const { return end - begin; }
+};
+
+bool is_space(char c) {
+	return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+}
+
+bool match_triple(const char *text, size_t i, size_t size, char c) {
+	return i + 2 < size && text[i] == c && text[i + 1] == c && text[i + 2] == c;
+}
+
+// Returns the index after the comment, string or asset path starting at i, or i if there is none there.
+// Brackets inside of these must not count towards the nesting depth
+size_t skip_literal(const char *text, size_t i, size_t size) {
+	const char c = text[i];
+
+	if (c == '#') {
+		while (i < size && text[i] != '\n') {
+			i++;
+		}
+		return i;
+	}
+
+	if (c == '"' || c == '\'') {
+		if (match_triple(text, i, size, c)) {
+			i += 3;
+			while (i < size && !match_triple(text, i, size, c)) {
+				i += text[i] == '\\' ? 2 : 1;
+			}
+			return std::min(i + 3, size);
+		}
+
+		i++;
+		while (i < size && text[i] != c && text[i] != '\n') {
+			i += text[i] == '\\' ? 2 : 1;
+		}
+		return std::min(i + 1, size);
+	}
+
+	if (c == '@') {
+		if (match_triple(text, i, size, '@')) {
+			i += 3;
+			while (i < size && !match_triple(text, i, size, '@')) {
+				i++;
+			}
+			return std::min(i + 3, size);
+		}
+
+		i++;
+		while (i < size && text[i] != '@' && text[i] != '\n') {
+			i++;
+		}
+		return std::min(i + 1, size);
+	}
+
+	return i;
+}
+
+bool is_prim_keyword(const char *text, size_t i, size_t end) {
+	static const char *keywords[] = { "def", "over", "class" };
+	for (const char *keyword : keywords) {
+		const size_t len = std::strlen(keyword);
+		if (i + len < end && std::strncmp(text + i, keyword, len) == 0 && is_space(text[i + len])) {
+			return true;
+		}
+	}
+	return false;
+}
+
+size_t line_begin(const char *text, size_t i, size_t begin) {
+	while (i > begin && text[i - 1] != '\n') {
+		i--;
+	}
+	return i;
+}
+
+// Collects all prim statements (def/over/class including metadata and body) directly inside [begin, end).
+// Ranges start at the beginning of the line of the statement
+bool scan_prims(const char *text, size_t begin, size_t end, std::vector<TextRange> *r_prims) {
+	int depth = 0;
+	bool in_prim = false;
+	bool in_prim_body = false;
+	TextRange current;
+
+	size_t i = begin;
+	while (i < end) {
+		const size_t after_literal = skip_literal(text, i, end);
+		if (after_literal != i) {
+			i = after_literal;
+			continue;
+		}
+
+		const char c = text[i];
+		switch (c) {
+			case '{':
+				if (depth == 0 && in_prim) {
+					in_prim_body = true;
+				}
+				depth++;
+				break;
+			case '(':
+			case '[':
+				depth++;
+				break;
+			case ')':
+			case ']':
+				depth--;
+				break;
+			case '}':
+				depth--;
+				if (depth == 0 && in_prim_body) {
+					current.end = i + 1;
+					r_prims->push_back(current);
+					in_prim = false;
+					in_prim_body = false;
+				}
+				break;
+			default:
+				if (depth == 0 && !in_prim && (i == begin || is_space(text[i - 1])) && is_prim_keyword(text, i, end)) {
+					in_prim = true;
+					current.begin = line_begin(text, i, begin);
+				}
+				break;
+		}
+
+		if (depth < 0) {
+			return false;
+		}
+		i++;
+	}
+
+	return depth == 0 && !in_prim;
+}
+
+// Returns the index of the '{' opening the prim body
+size_t find_prim_body(const char *text, const TextRange &prim) {
+	int depth = 0;
+	size_t i = prim.begin;
+	while (i < prim.end) {
+		const size_t after_literal = skip_literal(text, i, prim.end);
+		if (after_literal != i) {
+			i = after_literal;
+			continue;
+		}
+
+		const char c = text[i];
+		if (c == '{' && depth == 0) {
+			return i;
+		} else if (c == '(' || c == '[' || c == '{') {
+			depth++;
+		} else if (c == ')' || c == ']' || c == '}') {
+			depth--;
+		}
+		i++;
+	}
+	return prim.end;
+}
+
+// Splits ranges into at most max_groups consecutive groups of similar byte size
+std::vector<std::vector<TextRange>> group_ranges(const std::vector<TextRange> &ranges, size_t max_groups) {
+	size_t total = 0;
+	for (const TextRange &range : ranges) {
+		total += range.size();
+	}
+
+	const size_t target = total / max_groups + 1;
+	std::vector<std::vector<TextRange>> groups(1);
+	size_t group_size = 0;
+	for (const TextRange &range : ranges) {
+		if (group_size >= target && groups.size() < max_groups) {
+			groups.emplace_back();
+			group_size = 0;
+		}
+		groups.back().push_back(range);
+		group_size += range.size();
+	}
+	return groups;
+}
+
+bool is_identifier_char(char c) {
+	return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_' || c == ':';
+}
+
+// Extends the last span if data continues it, so untouched stretches of the layer stay one span
+void append_span(UsdaChunk &r_chunk, const char *data, size_t size) {
+	if (size == 0) {
+		return;
+	}
+	if (!r_chunk.spans.empty()) {
+		UsdaSpan &last = r_chunk.spans.back();
+		if (last.data + last.size == data) {
+			last.size += size;
+			return;
+		}
+	}
+	r_chunk.spans.push_back({ data, size });
+}
+
+void append_literal(UsdaChunk &r_chunk, const char *literal) {
+	append_span(r_chunk, literal, std::strlen(literal));
+}
+
+} // namespace
+
+size_t UsdaChunk::size() const {
+	size_t total = 0;
+	for (const UsdaSpan &span : spans) {
+		total += span.size;
+	}
+	return total;
+}
+
+std::string UsdaChunk::join() const {
+	std::string text;
+	text.reserve(size());
+	for (const UsdaSpan &span : spans) {
+		text.append(span.data, span.size);
+	}
+	return text;
+}
+
+bool split_usda_layer(const char *text, size_t size, size_t max_chunks, UsdaChunks *r_chunks) {
+	r_chunks->chunks.clear();
+	r_chunks->split_root_children = false;
+
+	if (max_chunks < 2) {
+		return false;
+	}
+
+	std::vector<TextRange> root_prims;
+	if (!scan_prims(text, 0, size, &root_prims) || root_prims.empty()) {
+		return false;
+	}
+
+	// Layer metadata is everything before the first prim, every chunk needs it for e.g. upAxis
+	const size_t header_size = root_prims[0].begin;
+
+	if (root_prims.size() > 1) {
+		for (const std::vector<TextRange> &group : group_ranges(root_prims, max_chunks)) {
+			// Only whitespace and comments are between root prims, so a group is one slice of the layer.
+			// The first group directly follows the header, so that chunk is a single span
+			UsdaChunk chunk;
+			append_span(chunk, text, header_size);
+			append_span(chunk, text + group.front().begin, group.back().end - group.front().begin);
+			r_chunks->chunks.push_back(std::move(chunk));
+		}
+		return r_chunks->chunks.size() > 1;
+	}
+
+	// Single root prim (which is what e.g. blender exports), so split its children instead
+	const TextRange &root = root_prims[0];
+	const size_t body_open = find_prim_body(text, root);
+	if (body_open >= root.end) {
+		return false;
+	}
+	const size_t body_close = root.end - 1;
+
+	std::vector<TextRange> children;
+	if (!scan_prims(text, body_open + 1, body_close, &children) || children.size() < 2) {
+		return false;
+	}
+
+	const std::vector<std::vector<TextRange>> groups = group_ranges(children, max_chunks);
+	if (groups.size() < 2) {
+		return false;
+	}
+
+	for (size_t group_idx = 0; group_idx < groups.size(); group_idx++) {
+		// The layer header and the root prim header are one slice
+		UsdaChunk chunk;
+		append_span(chunk, text, body_open + 1);
+
+		if (group_idx == 0) {
+			// The first chunk keeps everything of the root body except the children of the other chunks,
+			// this way properties and variant sets of the root end up in the merged stage as well
+			size_t cursor = body_open + 1;
+			for (size_t other_idx = 1; other_idx < groups.size(); other_idx++) {
+				for (const TextRange &child : groups[other_idx]) {
+					append_span(chunk, text + cursor, child.begin - cursor);
+					cursor = child.end;
+				}
+			}
+			append_span(chunk, text + cursor, body_close - cursor);
+		} else {
+			append_literal(chunk, "\n");
+			for (const TextRange &child : groups[group_idx]) {
+				append_span(chunk, text + child.begin, child.size());
+				append_literal(chunk, "\n");
+			}
+		}
+
+		append_literal(chunk, "\n}\n");
+		r_chunks->chunks.push_back(std::move(chunk));
+	}
+
+	r_chunks->split_root_children = true;
+	return true;
+}
+
+bool usda_has_composition_arcs(const char *text, size_t size) {
+	static const char *keywords[] = { "subLayers", "references", "payload", "inherits", "specializes", "variantSets", "variantSet" };
+
+	size_t i = 0;
+	while (i < size) {
+		const size_t after_literal = skip_literal(text, i, size);
+		if (after_literal != i) {
+			i = after_literal;
+			continue;
+		}
+
+		if (!is_identifier_char(text[i])) {
+			i++;
+			continue;
+		}
+
+		size_t end = i;
+		while (end < size && is_identifier_char(text[end])) {
+			end++;
+		}
+		for (const char *keyword : keywords) {
+			const size_t len = std::strlen(keyword);
+			if (end - i == len && std::strncmp(text + i, keyword, len) == 0) {
+				return true;
+			}
+		}
+		i = end;
+	}
+	return false;
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+/// Slice of the layer text or of a string literal, chunks never copy the layer
+struct UsdaSpan {
+	const char *data = nullptr;
+	size_t size = 0;
+};
+
+/// A self-contained layer made of spans
+struct UsdaChunk {
+	std::vector<UsdaSpan> spans;
+
+	size_t size() const;
+	/// Copies the spans into one buffer for the parser. A chunk of a single span is parsed in place instead
+	std::string join() const;
+};
+
+/// A USDA layer split into self-contained layers that can be parsed independently
+struct UsdaChunks {
+	/// If true the layer has a single root prim and every chunk contains that root prim with a part of its children.
+	/// Otherwise every chunk contains a part of the root prims
+	bool split_root_children = false;
+	std::vector<UsdaChunk> chunks;
+};
+
+/// Splits a USDA layer at prim boundaries into at most max_chunks chunks of roughly the same size.
+/// Every chunk repeats the layer header (and root prim header if split_root_children), so each one is valid USDA.
+/// The chunks point into text, which has to outlive them.
+/// Returns false if the layer can't be split, e.g. because it only has one prim.
+bool split_usda_layer(const char *text, size_t size, size_t max_chunks, UsdaChunks *r_chunks);
+
+/// Returns true if the layer might have sublayers, references, payloads, inherits, specializes or variant sets.
+/// Only looks for their keywords outside of strings and comments, so it never misses one but can report one that isn't there
+bool usda_has_composition_arcs(const char *text, size_t size);
@@ -0,0 +1,169 @@
+#include "utils/usdz_archive.h"
+
+#include <cstring>
+
+#include "external/miniz.h"
+
+static constexpr uint32_t ZIP_LOCAL_HEADER_SIGNATURE = 0x04034b50;
+static constexpr size_t ZIP_LOCAL_HEADER_SIZE = 30;
+
+static uint16_t read_u16(const uint8_t *p) {
+	return static_cast<uint16_t>(p[0] | (p[1] << 8));
+}
+
+static uint32_t read_u32(const uint8_t *p) {
+	return static_cast<uint32_t>(p[0] | (p[1] << 8) | (p[2] << 16) | (static_cast<uint32_t>(p[3]) << 24));
+}
+
+static bool is_usd_layer_name(const std::string &name) {
+	const size_t dot = name.find_last_of('.');
+	if (dot == std::string::npos) {
+		return false;
+	}
+	const std::string ext = name.substr(dot + 1);
+	return ext == "usd" || ext == "usda" || ext == "usdc";
+}
+
+std::string UsdzArchive::normalize_name(const std::string &name) {
+	std::string result = name;
+	while (result.rfind("./", 0) == 0) {
+		result = result.substr(2);
+	}
+	return result;
+}
+
+bool UsdzArchive::open(const std::string &path, std::string *err) {
+	_entries.clear();
+	_root_layer.clear();
+
+	if (!_file.open(path, err)) {
+		return false;
+	}
+
+	// miniz only reads the central directory here, entry data is never touched
+	mz_zip_archive zip;
+	std::memset(&zip, 0, sizeof(zip));
+	if (!mz_zip_reader_init_mem(&zip, _file.data(), _file.size(), 0)) {
+		if (err) {
+			*err = "Failed to read usdz archive: " + std::string(mz_zip_get_error_string(mz_zip_get_last_error(&zip)));
+		}
+		return false;
+	}
+
+	const mz_uint num_files = mz_zip_reader_get_num_files(&zip);
+	for (mz_uint i = 0; i < num_files; i++) {
+		mz_zip_archive_file_stat stat;
+		if (!mz_zip_reader_file_stat(&zip, i, &stat) || stat.m_is_directory) {
+			continue;
+		}
+
+		const size_t header_offset = static_cast<size_t>(stat.m_local_header_ofs);
+		if (header_offset + ZIP_LOCAL_HEADER_SIZE > _file.size()) {
+			continue;
+		}
+
+		const uint8_t *header = _file.data() + header_offset;
+		if (read_u32(header) != ZIP_LOCAL_HEADER_SIGNATURE) {
+			continue;
+		}
+
+		Entry entry;
+		entry.index = i;
+		entry.offset = header_offset + ZIP_LOCAL_HEADER_SIZE + read_u16(header + 26) + read_u16(header + 28);
+		entry.size = static_cast<size_t>(stat.m_comp_size);
+		// usdz requires stored entries, but some packers compress anyway. Those get extracted on demand
+		entry.stored = stat.m_method == 0 && stat.m_comp_size == stat.m_uncomp_size;
+
+		if (entry.offset + entry.size > _file.size()) {
+			continue;
+		}
+
+		const std::string name = stat.m_filename;
+		if (_root_layer.empty() && is_usd_layer_name(name)) {
+			_root_layer = name;
+		}
+		_entries[name] = entry;
+	}
+
+	mz_zip_reader_end(&zip);
+
+	if (_root_layer.empty()) {
+		if (err) {
+			*err = "No USD layer found in usdz archive";
+		}
+		return false;
+	}
+
+	return true;
+}
+
+bool UsdzArchive::has_entry(const std::string &name) const {
+	return _entries.find(normalize_name(name)) != _entries.end();
+}
+
+bool UsdzArchive::get_stored_entry(const std::string &name, const uint8_t **r_data, size_t *r_size) const {
+	const auto it = _entries.find(normalize_name(name));
+	if (it == _entries.end() || !it->second.stored) {
+		return false;
+	}
+
+	*r_data = _file.data() + it->second.offset;
+	*r_size = it->second.size;
+	return true;
+}
+
+bool UsdzArchive::extract_entry(const std::string &name, std::vector<uint8_t> *r_data, std::string *err) const {
+	const auto it = _entries.find(normalize_name(name));
+	if (it == _entries.end()) {
+		if (err) {
+			*err = "Entry not found in usdz archive: " + name;
+		}
+		return false;
+	}
+
+	const Entry &entry = it->second;
+	if (entry.stored) {
+		const uint8_t *begin = _file.data() + entry.offset;
+		r_data->assign(begin, begin + entry.size);
+		return true;
+	}
+
+	mz_zip_archive zip;
+	std::memset(&zip, 0, sizeof(zip));
+	if (!mz_zip_reader_init_mem(&zip, _file.data(), _file.size(), 0)) {
+		if (err) {
+			*err = "Failed to read usdz archive";
+		}
+		return false;
+	}
+
+	size_t size = 0;
+	void *data = mz_zip_reader_extract_to_heap(&zip, entry.index, &size, 0);
+	mz_zip_reader_end(&zip);
+
+	if (!data) {
+		if (err) {
+			*err = "Failed to decompress usdz entry: " + name;
+		}
+		return false;
+	}
+
+	const uint8_t *bytes = static_cast<const uint8_t *>(data);
+	r_data->assign(bytes, bytes + size);
+	mz_free(data);
+	return true;
+}
+
+void UsdzArchive::fill_usdz_asset(tinyusdz::USDZAsset *r_asset) const {
+	r_asset->asset_map.clear();
+	r_asset->data.clear();
+	r_asset->addr = _file.data();
+	r_asset->size = _file.size();
+
+	// tinyusdz can only resolve stored entries, it doesn't decompress
+	for (const auto &it : _entries) {
+		if (it.second.stored) {
+			r_asset->asset_map[it.first] = std::make_pair(it.second.offset, it.second.offset + it.second.size);
+		}
+	}
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "tinyusdz.hh"
+#include "utils/io_utils.h"
+
+/// Read-only view of a .usdz package. The archive stays mapped for as long as this object lives,
+/// stored (uncompressed) entries are handed out as pointers into the mapping without copying
+class UsdzArchive {
+private:
+	struct Entry {
+		size_t offset = 0;
+		size_t size = 0;
+		uint32_t index = 0;
+		bool stored = true;
+	};
+
+	MappedFile _file;
+	std::map<std::string, Entry> _entries;
+	/// First USD layer in the archive, which is the root layer by the usdz spec
+	std::string _root_layer;
+
+public:
+	bool open(const std::string &path, std::string *err);
+
+	bool has_entry(const std::string &name) const;
+	const std::string &get_root_layer_name() const { return _root_layer; }
+
+	/// Returns false if the entry is compressed and can't be accessed without extracting it
+	bool get_stored_entry(const std::string &name, const uint8_t **r_data, size_t *r_size) const;
+	/// Returns a copy of the entry, decompressing it if needed
+	bool extract_entry(const std::string &name, std::vector<uint8_t> *r_data, std::string *err) const;
+
+	/// Fills the asset info tinyusdz needs for resolving assets (e.g. textures) inside the archive
+	void fill_usdz_asset(tinyusdz::USDZAsset *r_asset) const;
+
+	/// Entry names are relative to the archive root, this strips "./" prefixes of asset paths
+	static std::string normalize_name(const std::string &name);
+};